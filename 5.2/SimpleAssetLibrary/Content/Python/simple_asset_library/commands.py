@@ -1,28 +1,22 @@
 
-import json
-import os
-from pathlib import Path
 import typing
 import unreal
 
-from simple_asset_library import (
-    config,
-    metadata,
-)
+from simple_asset_library import config
 from simple_asset_library.unreal_systems import (
-    EditorActorSubsystem,
-    EditorAssetSubsystem,
-    EditorUtilitySubsystem,
     log,
-    UnrealEditorSubsystem
+    SimpleAssetLibrarySubsystem
 )
 
 
 ENTRY_DATA_CLASS = unreal.load_asset('/SimpleAssetLibrary/tool/widgets/asset_library_entry_data').generated_class()
-SPAWNED_ACTOR_TAG = "Asset Library Spawned"
 ALL = "all"
 
-cached_asset_types = dict()
+# The updates of a window whose settings are restored, see SimpleAssetLibrarySubsystem.mark_library_panel_dirty
+_ALL_PANEL_UPDATES = (
+    unreal.SimpleAssetLibraryPanelDirty.TYPE.value | unreal.SimpleAssetLibraryPanelDirty.CATEGORY.value
+    | unreal.SimpleAssetLibraryPanelDirty.FILTER.value | unreal.SimpleAssetLibraryPanelDirty.SIZE.value
+)
 
 
 def get_available_asset_types(include_all_option: bool = True) -> typing.List[str]:
@@ -35,12 +29,27 @@ def get_available_asset_types(include_all_option: bool = True) -> typing.List[st
     Returns:
         list(str) the list of asset types from the config file
     """
-    global cached_asset_types
-    if not cached_asset_types.get(include_all_option):
-        base_list = [ALL] if include_all_option else []
-        cached_asset_types[include_all_option] = base_list + config.get_config_asset_types()
-        log(f"Found the following asset types: {cached_asset_types}")
-    return cached_asset_types[include_all_option]
+    return [str(asset_type) for asset_type in SimpleAssetLibrarySubsystem.get_available_asset_types(include_all_option)]
+
+
+def get_undeclared_asset_types() -> typing.List[str]:
+    """
+    Get the asset types used by Asset Library entries that are missing from the asset_types of the config
+
+    Returns:
+        list(str) the undeclared asset types
+    """
+    return [str(asset_type) for asset_type in SimpleAssetLibrarySubsystem.get_undeclared_asset_types()]
+
+
+def get_unused_asset_types() -> typing.List[str]:
+    """
+    Get the asset types of the config that no Asset Library entry uses
+
+    Returns:
+        list(str) the unused asset types
+    """
+    return [str(asset_type) for asset_type in SimpleAssetLibrarySubsystem.get_unused_asset_types()]
 
 
 def get_available_asset_categories(asset_type: str = ALL, include_all_option: bool = True) -> typing.List[str]:
@@ -57,24 +66,11 @@ def get_available_asset_categories(asset_type: str = ALL, include_all_option: bo
     Returns:
         list(str) the list of asset types from the config file
     """
-    categories = config.get_config_default_categories() if asset_type != ALL else []
-
-    meta_query = {metadata.META_MANAGED_ASSET: True}
-    if asset_type.lower() != ALL:
-        meta_query = meta_query | {metadata.META_ASSET_TYPE: asset_type}
-
-    # Get the user added categories from Unreal
-    user_added_categories = [
-        metadata.get_asset_metadata(item, metadata.META_ASSET_CATEGORY)
-        for item in metadata.find_assets(meta_query)
-        if metadata.get_asset_metadata(item, metadata.META_ASSET_CATEGORY)
+    return [
+        str(category)
+        for category in SimpleAssetLibrarySubsystem.get_available_asset_categories(asset_type, include_all_option)
     ]
 
-    # Remove any duplicates and organize the list
-    base_list = [ALL] if include_all_option else []
-    categories = base_list + sorted(set(categories + user_added_categories))
-    return categories
-
 
 def get_asset_list(asset_type: str = ALL, category: str = ALL) -> typing.List[unreal.AssetData]:
     """
@@ -87,94 +83,72 @@ def get_asset_list(asset_type: str = ALL, category: str = ALL) -> typing.List[un
     Returns:
 
     """
-    meta_query = {metadata.META_MANAGED_ASSET: True}
-    if asset_type.lower() != ALL:
-        meta_query = meta_query | {metadata.META_ASSET_TYPE: asset_type}
-    if category.lower() != ALL:
-        meta_query = meta_query | {metadata.META_ASSET_CATEGORY: category}
-
-    return metadata.find_assets(meta_query)
+    # The native library index is restored from its manifest, this avoids enumerating the Asset Registry
+    return list(unreal.SimpleAssetLibraryBPLibrary.query_library_assets(asset_type, category))
 
 
-def get_asset_list_for_gui(asset_type: str) -> typing.List[unreal.EditorUtilityObject]:
+def get_asset_list_for_gui(asset_type: str, asset_library_instance=None) -> typing.List[unreal.EditorUtilityObject]:
     """
     get the list of assets to use for the Asset Library GUI
 
     Args:
         asset_type (str): the asset type to get the assets for
+        asset_library_instance (unreal.EditorUtilityWidget): the window asking for the list, the current window if None
 
     Returns:
         list(unreal.EditorUtilityObject) the list of assets as asset library entry data objects
     """
-
-    # Get the managed assets as a list of entry data objects
-    entries = []
-    for asset_data in get_asset_list(asset_type):
-        new_entry = unreal.new_object(ENTRY_DATA_CLASS)
-        new_entry.set_editor_properties({
-            "asset_data": asset_data,
-            "asset_path": str(asset_data.package_name),
-            "asset_metadata": EditorAssetSubsystem.get_metadata_tag_values(asset_data.get_asset()),
-            "asset_display_name": metadata.get_asset_metadata(asset_data, metadata.META_DISPLAY_NAME, ""),
-            "asset_type": metadata.get_asset_metadata(asset_data, metadata.META_ASSET_TYPE, ""),
-            "asset_category": metadata.get_asset_metadata(asset_data, metadata.META_ASSET_CATEGORY, "default"),
-            "added_by": metadata.get_asset_metadata(asset_data, metadata.META_ADDED_BY, "unknown"),
-            "unreal_class": str(asset_data.asset_class_path.asset_name)
-        })
-        entries.append(new_entry)
-
-    # Show the 'Add Entry' button if enabled
-    asset_library_instance = get_asset_libary_instance()
-    if asset_library_instance and asset_library_instance.get_editor_property("show_add_entry_button"):
-        new_entry_button = unreal.new_object(ENTRY_DATA_CLASS)
-        new_entry_button.set_editor_property("is_new_entry_button", True)
-        entries.append(new_entry_button)
-
-    log(f"found {len(entries)} registered assets of type {asset_type}")
-    return entries
+    # The entry data objects are created natively from the library index, no asset is loaded to build the list
+    asset_library_instance = asset_library_instance or get_asset_libary_instance()
+    # A window with an update marked gets its list at the end of the frame, the one asked for meanwhile would be replaced
+    if asset_library_instance and SimpleAssetLibrarySubsystem.is_library_panel_update_pending(asset_library_instance):
+        return []
+    show_add_entry_button = bool(
+        asset_library_instance and asset_library_instance.get_editor_property("show_add_entry_button")
+    )
+    return list(SimpleAssetLibrarySubsystem.get_gui_entries(
+        ENTRY_DATA_CLASS, asset_type, show_add_entry_button, asset_library_instance
+    ))
 
 
 def filter_asset_list_for_gui(
         entries: typing.List[unreal.EditorUtilityObject],
         category: typing.Optional[str] = None,
-        string_in_name: typing.Optional[str] = None
+        string_in_name: typing.Optional[str] = None,
+        added_by: typing.Optional[str] = None,
+        unreal_class: typing.Optional[str] = None,
+        include_derived_classes: bool = False
 ) -> typing.List[unreal.EditorUtilityObject]:
     """
-    Filter the asset list to only those matching the provided category and/or string
+    Filter the asset list to only those matching the provided category, string and/or author
 
     Args:
         entries (list(unreal.EditorUtilityObject)): the list of asset library entry data objects
         category (str): if provided, filter for the assets matching the given category
         string_in_name (str): if provided, filter for the assets matching the given name (Display name or Asset name)
+        added_by (str): if provided, filter for the assets added by the given user
+        unreal_class (str): if provided, filter for the assets of the given class, as a class name (StaticMesh) or a class path
+        include_derived_classes (bool): whether the assets of classes derived from unreal_class match too
 
     Returns:
-        list(unreal.EditorUtilityObject) the list of assets matching the category + name filter
-    """
-    string_in_name = str(string_in_name) if string_in_name else None
-    filtered_entries = entries.copy()
-
-    # Filter for category matches if provided
-    # Category should be a 1:1 match as it's managed entirely by the Asset Library
-    if category and category.lower() != ALL:
-        filtered_entries = [
-            item
-            for item in filtered_entries
-            if item.get_editor_property("asset_metadata").get(metadata.META_ASSET_CATEGORY) == category
-            or item.get_editor_property("is_new_entry_button")
-        ]
-
-    # Filter for str in name if provided
-    # Will check if the given string is in the display name or unreal asset name
+        list(unreal.EditorUtilityObject) the list of assets matching the category + name + author + class filter
+    """
+    asset_library_instance = get_asset_libary_instance()
+    if asset_library_instance and SimpleAssetLibrarySubsystem.is_library_panel_update_pending(asset_library_instance):
+        return []
+
+    # The criteria are evaluated together by the native index on its per-value bitsets
+    library_filter = unreal.SimpleAssetLibraryFilter()
+    if category:
+        library_filter.categories = [category]
+    if added_by:
+        library_filter.added_by = [added_by]
+    if unreal_class:
+        library_filter.unreal_classes = [unreal_class]
+        library_filter.include_derived_classes = include_derived_classes
     if string_in_name:
-        filtered_entries = [
-            item
-            for item in filtered_entries
-            if string_in_name.lower() in str(item.get_editor_property("asset_display_name") or "").lower()
-            or string_in_name.lower() in str(item.get_editor_property("asset_path") or "").split("/")[-1].lower()
-            or item.get_editor_property("is_new_entry_button")
-        ]
-    log(f"{len(filtered_entries)}/{len(entries)} entries match the current display filter")
-    return filtered_entries
+        library_filter.search_text = str(string_in_name)
+    return list(SimpleAssetLibrarySubsystem.filter_gui_entries(entries, library_filter))
 
 
 def register_asset(asset: typing.Union[unreal.Object, str], asset_type: str, category: str, display_name: str):
@@ -189,20 +163,7 @@ def register_asset(asset: typing.Union[unreal.Object, str], asset_type: str, cat
     """
     if isinstance(asset, str):
         asset = unreal.load_asset(asset)
-
-    data = {
-        metadata.META_MANAGED_ASSET: True,
-        metadata.META_ASSET_TYPE: asset_type,
-        metadata.META_ASSET_CATEGORY: category,
-        metadata.META_DISPLAY_NAME: display_name,
-        metadata.META_ADDED_BY: os.getlogin()
-    }
-    metadata.set_asset_metadata(asset, data)
-    log(
-        f"{asset.get_outer().get_path_name()} has been added to the Asset Library"
-        f"\ndetails:\n\tasset: {asset.get_outer().get_path_name()}"
-        f"\n\tdisplay name: {display_name}\n\tasset type: {asset_type}\n\tcategory: {category}"
-    )
+    SimpleAssetLibrarySubsystem.register_asset(asset, asset_type, category, display_name)
 
 
 def unregister_asset(asset: typing.Union[unreal.Object, str]):
@@ -214,11 +175,7 @@ def unregister_asset(asset: typing.Union[unreal.Object, str]):
     """
     if isinstance(asset, str):
         asset = unreal.load_asset(asset)
-
-    metadata.remove_asset_metadata(asset)
-    log(
-        f"{asset.get_outer().get_path_name()} has been removed from the Asset Library"
-    )
+    SimpleAssetLibrarySubsystem.unregister_asset(asset)
 
     # Refresh the UI
     asset_library_instance = get_asset_libary_instance()
@@ -226,6 +183,27 @@ def unregister_asset(asset: typing.Union[unreal.Object, str]):
         load_settings()
 
 
+def export_shared_library_pack(pack_folder: typing.Optional[str] = None) -> bool:
+    """
+    Export the library index and thumbnails as a read-only pack to share through source control
+
+    Args:
+        pack_folder (str): the folder to export to, defaults to the shared library pack from the config
+
+    Returns:
+        bool: whether the pack was exported
+    """
+    pack_folder = pack_folder or config.get_config_shared_library_pack()
+    if not pack_folder:
+        unreal.SimpleAssetLibraryBPLibrary.warning("No shared library pack folder is configured")
+        return False
+
+    exported = unreal.SimpleAssetLibraryBPLibrary.export_shared_library_pack(pack_folder)
+    if exported:
+        log(f"Exported the shared library pack to {pack_folder}, submit it to share it with the team")
+    return exported
+
+
 def get_asset_library_data_for_asset(asset: typing.Union[unreal.Object, str]) -> typing.Tuple[bool, str, str, str]:
     """
     Get the Asset Library data for the given asset
@@ -241,13 +219,35 @@ def get_asset_library_data_for_asset(asset: typing.Union[unreal.Object, str]) ->
     if not asset:
         return False, "", "", ""
 
-    default_name = str(asset.get_name()).replace("_", " ").title()
-    return (
-        bool(metadata.get_asset_metadata(asset, metadata.META_MANAGED_ASSET, False)),
-        metadata.get_asset_metadata(asset, metadata.META_ASSET_TYPE, ""),
-        metadata.get_asset_metadata(asset, metadata.META_ASSET_CATEGORY, ""),
-        metadata.get_asset_metadata(asset, metadata.META_DISPLAY_NAME) or default_name
-    )
+    is_managed, asset_type, category, display_name = SimpleAssetLibrarySubsystem.get_asset_library_data(asset)
+    return bool(is_managed), str(asset_type), str(category), str(display_name)
+
+
+def get_load_set_description(asset_path: str) -> str:
+    """
+    Describe what placing a library entry loads, for the entry tooltip
+
+    Args:
+        asset_path (str): the package path of the library entry
+
+    Returns:
+        str: the number of dependencies and the size on disk loaded with the entry
+    """
+    # the dependency closure is resolved natively from the Asset Registry and cached
+    return str(unreal.SimpleAssetLibraryBPLibrary.get_library_entry_load_set_text(asset_path))
+
+
+def prefetch_asset(asset_path: str) -> bool:
+    """
+    Async load a library entry and its dependencies before it is placed
+
+    Args:
+        asset_path (str): the package path of the library entry
+
+    Returns:
+        bool: whether the prefetch was started
+    """
+    return unreal.SimpleAssetLibraryBPLibrary.prefetch_library_entry(asset_path)
 
 
 def spawn_asset_in_viewport(asset_to_spawn: unreal.Object, display_name: str) -> typing.Optional[unreal.Actor]:
@@ -261,90 +261,68 @@ def spawn_asset_in_viewport(asset_to_spawn: unreal.Object, display_name: str) ->
     Returns:
         unreal.Actor: the newly spawned actor
     """
-
-    # Get Mouse position if it's over a viewport
-    origin, direction = unreal.SimpleAssetLibraryBPLibrary.get_editor_viewport_mouse_position_ws() or (None, None)
-    if not origin:
-        unreal.SimpleAssetLibraryBPLibrary.warning(
-            f"Mouse is not currently over a viewport, cannot spawn {asset_to_spawn.get_path_name()}"
-        )
-        return None
-
-    # Default settings
-    align_to_surface = True
-    ignore_placed_assets = True
-    select_after_spawning = True
-    max_distance = 10000
-
     # Get the settings from Asset Library instance
+    spawn_settings = unreal.SimpleAssetLibrarySpawnSettings()
     asset_library_instance = get_asset_libary_instance()
     if asset_library_instance:
-        align_to_surface = asset_library_instance.get_editor_property("align_to_surface")
-        ignore_placed_assets = asset_library_instance.get_editor_property("ignore_placed_assets")
-        select_after_spawning = asset_library_instance.get_editor_property("select_after_spawning")
-        max_distance = asset_library_instance.get_editor_property("max_distance") or max_distance
-
-    # [OPTIONAL] ignore actors spawned from the Asset Library
-    actors_to_ignore = unreal.GameplayStatics.get_all_actors_with_tag(
-        UnrealEditorSubsystem.get_editor_world(),
-        SPAWNED_ACTOR_TAG
-    ) if ignore_placed_assets else []
-
-    # Perform a hit test to find any surfaces under the mouse
-    destination = direction * max_distance + origin
-    hit_test_results = unreal.SystemLibrary.sphere_trace_single(
-        UnrealEditorSubsystem.get_editor_world(),
-        start=origin,
-        end=destination,
-        radius=1.0,
-        trace_channel=unreal.TraceTypeQuery.TRACE_TYPE_QUERY1,
-        trace_complex=True,
-        actors_to_ignore=actors_to_ignore,
-        draw_debug_type=unreal.DrawDebugTrace.NONE
-    )
+        spawn_settings.align_to_surface = asset_library_instance.get_editor_property("align_to_surface")
+        spawn_settings.ignore_placed_assets = asset_library_instance.get_editor_property("ignore_placed_assets")
+        spawn_settings.select_after_spawning = asset_library_instance.get_editor_property("select_after_spawning")
+        spawn_settings.max_distance = asset_library_instance.get_editor_property("max_distance") or spawn_settings.max_distance
 
-    # Get Location + Normal of impact or use default if too far away from camera
-    if hit_test_results:  # and hit_test_results.to_tuple()[3] < max_distance:
-        spawn_location, impact_location, spawn_normal, impact_normal = hit_test_results.to_tuple()[4:8]
-    else:
-        unreal.SimpleAssetLibraryBPLibrary.warning(
-            f"No hit test results, will spawn 10 units in front of camera"
-        )
-        spawn_location = direction * 1000 + origin
-        spawn_normal = unreal.Vector(0, 0, 1)
-
-    # Spawn rotation
-    spawn_rotation = unreal.Rotator(0, 0, 0)
-    if align_to_surface:
-        # Convert the hit test normal to a rotator
-        normal_to_vector = unreal.MathLibrary.conv_vector_to_rotator(spawn_normal)
-        spawn_rotation = unreal.Rotator(0, -90, 0).combine(normal_to_vector)
-
-    # Spawn the actor & set its properties
-    new_actor = EditorActorSubsystem.spawn_actor_from_object(
-        asset_to_spawn,
-        spawn_location,
-        spawn_rotation
-    )
-    if not new_actor:
-        log(f"Failed to spawn {asset_to_spawn.get_outer().get_path_name()}, it may not be a valid actor-compatible asset!")
-        return None
+    return SimpleAssetLibrarySubsystem.spawn_asset_in_viewport(asset_to_spawn, display_name, spawn_settings)
 
-    new_actor.set_actor_label(display_name)
-    new_actor.tags.append(SPAWNED_ACTOR_TAG)
 
-    actor_folder_path = config.get_config_actor_folder_path()
-    if actor_folder_path:
-        new_actor.set_folder_path(actor_folder_path)
+def get_recent_assets() -> typing.List[unreal.SimpleAssetLibraryEntryInfo]:
+    """
+    Get the Asset Library entries the user placed recently, they are kept loaded
 
-    if select_after_spawning:
-        EditorActorSubsystem.set_selected_level_actors([new_actor])
+    Returns:
+        list(unreal.SimpleAssetLibraryEntryInfo): the recent entries, the most recent first
+    """
+    return list(unreal.SimpleAssetLibraryBPLibrary.get_recent_library_entries())
 
-    log(
-        f"Spawned asset {asset_to_spawn.get_outer().get_path_name()} from the Asset Library"
-    )
 
-    return new_actor
+def get_favorite_assets() -> typing.List[unreal.SimpleAssetLibraryEntryInfo]:
+    """
+    Get the favorite Asset Library entries of the user, they are kept loaded
+
+    Returns:
+        list(unreal.SimpleAssetLibraryEntryInfo): the favorite entries
+    """
+    return list(unreal.SimpleAssetLibraryBPLibrary.get_favorite_library_entries())
+
+
+def set_favorite_asset(asset_path: str, favorite: bool = True):
+    """
+    Add an Asset Library entry to the user's favorites or remove it
+
+    Args:
+        asset_path (str): the package path of the entry
+        favorite (bool): whether the entry is a favorite
+    """
+    unreal.SimpleAssetLibraryBPLibrary.set_library_entry_favorite(asset_path, favorite)
+
+
+def get_most_used_assets(max_entries: int = 16) -> typing.List[unreal.SimpleAssetLibraryEntryInfo]:
+    """
+    Get the Asset Library entries the user placed the most, from the local usage log
+
+    Args:
+        max_entries (int): the maximum number of entries to return
+
+    Returns:
+        list(unreal.SimpleAssetLibraryEntryInfo): the entries, the most placed first
+    """
+    return list(unreal.SimpleAssetLibraryBPLibrary.get_most_used_library_entries(max_entries))
+
+
+def log_thumbnail_dedup():
+    """
+    Log how many thumbnail textures the shown Asset Library entries share, identical thumbnails show one texture
+    """
+    ratio, num_entries, num_textures = unreal.SimpleAssetLibraryBPLibrary.get_library_thumbnail_dedup()
+    unreal.log(f"Asset Library thumbnails: {num_entries} entries show {num_textures} textures ({ratio:.0%} deduplicated)")
 
 
 def get_color_for_asset_type(asset_type) -> unreal.LinearColor:
@@ -357,95 +335,109 @@ def get_color_for_asset_type(asset_type) -> unreal.LinearColor:
     Returns:
         unreal.LinearColor: a Linear Color object of the unique color for that asset type
     """
-    if asset_type.lower() == ALL:
-        return unreal.LinearColor(1, 1, 1, 1)
-
-    # Determine the Hue (0-359)
-    available_asset_types = get_available_asset_types(False)
-    hue = 0
-    if asset_type in available_asset_types:
-        hue = available_asset_types.index(asset_type) / len(available_asset_types) * 359
+    return SimpleAssetLibrarySubsystem.get_asset_type_color(asset_type)
 
-    asset_type_color = unreal.LinearColor()
-    asset_type_color.set_from_hsv(hue, 0.8, 0.8, 0.5)
-    return asset_type_color
 
-
-def save_settings():
+def save_settings(asset_library_instance=None):
     """
-    Save the user settings to disk for the Asset Library instance
+    Save the user settings of the Asset Library instance, they are written to disk in the background
+
+    Args:
+        asset_library_instance (unreal.EditorUtilityWidget): the window to save, the current window if None
     """
-    asset_library_instance = get_asset_libary_instance()
+    asset_library_instance = asset_library_instance or get_asset_libary_instance()
     if not asset_library_instance or not asset_library_instance.get_editor_property("can_save_settings"):
         return
 
-    prefs_file = Path(unreal.Paths.project_saved_dir(), f"Config/asset_library_prefs.json")
-    if not prefs_file.exists():
-        prefs_file.parent.mkdir(parents=True, exist_ok=True)
-
-    with prefs_file.open("w", encoding="utf-8") as f:
-        asset_type, asset_category, name_filter = asset_library_instance.call_method("get_menu_state")
-        prefs_data = {
-            "align_to_surface": asset_library_instance.get_editor_property("align_to_surface"),
-            "ignore_placed_assets": asset_library_instance.get_editor_property("ignore_placed_assets"),
-            "select_after_spawning": asset_library_instance.get_editor_property("select_after_spawning"),
-            "max_distance": asset_library_instance.get_editor_property("max_distance"),
-            "show_add_entry_button": asset_library_instance.get_editor_property("show_add_entry_button"),
-            "show_delete_button": asset_library_instance.get_editor_property("show_delete_button"),
-            "entry_size": asset_library_instance.get_editor_property("entry_size"),
-            "ui_state_type": asset_type,
-            "ui_state_category": asset_category,
-            "ui_state_filter": name_filter,
-        }
-        json.dump(prefs_data, f, indent=2)
-
-
-def load_settings():
+    asset_type, asset_category, name_filter = asset_library_instance.call_method("get_menu_state")
+    prefs = unreal.SimpleAssetLibraryPrefs()
+    prefs.spawn_settings.align_to_surface = asset_library_instance.get_editor_property("align_to_surface")
+    prefs.spawn_settings.ignore_placed_assets = asset_library_instance.get_editor_property("ignore_placed_assets")
+    prefs.spawn_settings.select_after_spawning = asset_library_instance.get_editor_property("select_after_spawning")
+    prefs.spawn_settings.max_distance = asset_library_instance.get_editor_property("max_distance")
+    prefs.show_add_entry_button = asset_library_instance.get_editor_property("show_add_entry_button")
+    prefs.show_delete_button = asset_library_instance.get_editor_property("show_delete_button")
+    prefs.entry_size = asset_library_instance.get_editor_property("entry_size")
+    prefs.asset_type = str(asset_type or "")
+    prefs.category = str(asset_category or "")
+    prefs.search_text = str(name_filter or "")
+    panel_name = SimpleAssetLibrarySubsystem.get_library_panel_name(asset_library_instance)
+    SimpleAssetLibrarySubsystem.save_settings(prefs, panel_name)
+
+
+def load_settings(asset_library_instance=None):
     """
     Load the settings from disk for the Asset Library instance
+
+    Args:
+        asset_library_instance (unreal.EditorUtilityWidget): the window to restore, the window being constructed if None
     """
-    asset_library_instance = get_asset_libary_instance()
+    asset_library_instance = asset_library_instance or get_asset_libary_instance()
     if not asset_library_instance:
         return
 
-    prefs_file = Path(unreal.Paths.project_saved_dir(), f"Config/asset_library_prefs.json")
-    prefs_data = None
+    # Restoring the window changes its menus, don't save the settings back while they are applied.
+    # The list is got, filtered and laid out once at the end of the frame, after all the settings are set
+    asset_library_instance.set_editor_property("can_save_settings", False)
+    SimpleAssetLibrarySubsystem.mark_library_panel_dirty(asset_library_instance, _ALL_PANEL_UPDATES)
 
-    # Apply Asset Library settings
-    if prefs_file.exists():
-        prefs_data = json.loads(prefs_file.read_text())
+    # Apply Asset Library settings, the defaults are used if no settings were saved.
+    # The settings are read once per session, later loads come from memory
+    panel_name = SimpleAssetLibrarySubsystem.get_library_panel_name(asset_library_instance)
+    has_prefs, prefs = SimpleAssetLibrarySubsystem.load_settings(panel_name)
+    if has_prefs:
         asset_library_instance.set_editor_properties({
-            "align_to_surface": prefs_data.get("align_to_surface", True),
-            "ignore_placed_assets": prefs_data.get("ignore_placed_assets", True),
-            "select_after_spawning": prefs_data.get("select_after_spawning", True),
-            "show_add_entry_button": prefs_data.get("show_add_entry_button", True),
-            "show_delete_button": prefs_data.get("show_delete_button", False),
-            "max_distance": prefs_data.get("max_distance", 10000),
-            "entry_size": prefs_data.get("entry_size", 1.0),
+            "align_to_surface": prefs.spawn_settings.align_to_surface,
+            "ignore_placed_assets": prefs.spawn_settings.ignore_placed_assets,
+            "select_after_spawning": prefs.spawn_settings.select_after_spawning,
+            "show_add_entry_button": prefs.show_add_entry_button,
+            "show_delete_button": prefs.show_delete_button,
+            "max_distance": prefs.spawn_settings.max_distance,
+            "entry_size": prefs.entry_size,
         })
-    asset_library_instance.call_method("update_entry_size")
 
+    # Only the menu values that differ from the shown ones are set
     # Populate the asset type dropdown
     asset_library_instance.call_method("populate_asset_type_dropdown")
-    if prefs_data and prefs_data.get("ui_state_type"):
-        asset_library_instance.call_method("set_type_selection", (prefs_data.get("ui_state_type"),))
+    shown_type, _, _ = asset_library_instance.call_method("get_menu_state")
+    if has_prefs and prefs.asset_type and prefs.asset_type != str(shown_type or ""):
+        asset_library_instance.call_method("set_type_selection", (prefs.asset_type,))
 
     # Populate the asset category dropdown
     asset_library_instance.call_method("populate_category_query_dropdown")
-    if prefs_data and prefs_data.get("ui_state_category"):
-        asset_library_instance.call_method("set_category_selection", (prefs_data.get("ui_state_category"),))
+    _, shown_category, shown_filter = asset_library_instance.call_method("get_menu_state")
+    if has_prefs and prefs.category and prefs.category != str(shown_category or ""):
+        asset_library_instance.call_method("set_category_selection", (prefs.category,))
 
     # Populate the filter input field
-    if prefs_data and prefs_data.get("ui_state_filter"):
-        asset_library_instance.call_method("set_filter", (prefs_data.get("ui_state_filter"),))
+    if has_prefs and prefs.search_text and prefs.search_text != str(shown_filter or ""):
+        asset_library_instance.call_method("set_filter", (prefs.search_text,))
 
-    # Populate the UI
-    asset_library_instance.call_method("get_asset_list")
-    asset_library_instance.call_method("filter_asset_list")
     asset_library_instance.set_editor_property("can_save_settings", True)
 
 
+def open_asset_library(panel_name: str = "") -> typing.Optional[unreal.EditorUtilityWidget]:
+    """
+    Open an Asset Library window, every window has its own filter and they all share the library index
+
+    Args:
+        panel_name (str): the name of the window, like 'Props' or 'FX', empty for the main window
+
+    Returns:
+        unreal.EditorUtilityWidget: the Asset Library window
+    """
+    return SimpleAssetLibrarySubsystem.open_library_panel(panel_name)
+
+
+def refresh_open_asset_libraries():
+    """Get the entries of every open Asset Library window again, called when library entries are renamed, moved or deleted"""
+    for asset_library_instance in SimpleAssetLibrarySubsystem.get_library_panels():
+        SimpleAssetLibrarySubsystem.mark_library_panel_dirty(
+            asset_library_instance, unreal.SimpleAssetLibraryPanelDirty.TYPE.value
+        )
+
+
 def get_asset_libary_instance():
-    """Get the currently open instance of the Asset Library"""
-    asset = unreal.load_asset('/SimpleAssetLibrary/tool/AssetLibrary')
-    return EditorUtilitySubsystem.find_utility_widget_from_blueprint(asset)
+    """Get the instance of the Asset Library being constructed or else the one the user is using, the most recently opened one if none is"""
+    # The native registry of the open windows is updated when they open and close, nothing is loaded here
+    return SimpleAssetLibrarySubsystem.get_library_panel()
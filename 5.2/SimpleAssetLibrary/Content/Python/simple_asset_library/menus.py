@@ -3,7 +3,7 @@ import unreal
 
 from simple_asset_library.unreal_systems import (
     log,
-    EditorUtilitySubsystem
+    SimpleAssetLibrarySubsystem
 )
 
 
@@ -46,5 +46,4 @@ class AssetLibraryLauncher(unreal.ToolMenuEntryScript):
     def execute(self, context):
         """Open the Asset Library"""
         log(f"Launching the Simple Asset Library")
-        asset = unreal.load_asset('/SimpleAssetLibrary/tool/AssetLibrary')
-        EditorUtilitySubsystem.spawn_and_register_tab(asset)
+        SimpleAssetLibrarySubsystem.open_library_panel()
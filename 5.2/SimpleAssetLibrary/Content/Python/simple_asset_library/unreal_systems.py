@@ -17,6 +17,9 @@ EditorUtilitySubsystem = unreal.get_editor_subsystem(unreal.EditorUtilitySubsyst
 LevelEditorSubsystem   = unreal.get_editor_subsystem(unreal.LevelEditorSubsystem)
 UnrealEditorSubsystem  = unreal.get_editor_subsystem(unreal.UnrealEditorSubsystem)
 
+# The native Asset Library operations, the simple_asset_library modules forward to it
+SimpleAssetLibrarySubsystem = unreal.get_editor_subsystem(unreal.SimpleAssetLibrarySubsystem)
+
 
 # Asset Library logger
 def log(message: typing.Any):
@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SSimpleAssetLibraryTile.h"
+#include "SimpleAssetLibraryThumbnailCache.h"
+
+#include "Engine/Texture2D.h"
+#include "Widgets/Images/SImage.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
+
+
+void
+SSimpleAssetLibraryTile::Construct(const FArguments& InArgs)
+{
+    ChildSlot
+    [
+        SAssignNew(SizeBox, SBox)
+        .Padding(2.0f)
+        [
+            SNew(SVerticalBox)
+            + SVerticalBox::Slot()
+            .FillHeight(1.0f)
+            [
+                SNew(SImage)
+                .Image(&ThumbnailBrush)
+            ]
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .HAlign(HAlign_Center)
+            [
+                SNew(STextBlock)
+                .Text_Lambda([this]() { return DisplayName; })
+                .OverflowPolicy(ETextOverflowPolicy::Ellipsis)
+            ]
+        ]
+    ];
+    SetToolTipText(MakeAttributeSP(this, &SSimpleAssetLibraryTile::GetEntryToolTipText));
+}
+
+void
+SSimpleAssetLibraryTile::SetEntry(const FSimpleAssetLibraryEntryInfo& Entry, UTexture2D* DefaultThumbnail)
+{
+    DisplayName = FText::FromString(Entry.DisplayName.IsEmpty() ? Entry.AssetData.AssetName.ToString() : Entry.DisplayName);
+    PackageName = Entry.AssetData.PackageName;
+
+    // Another window showing the entry already created its thumbnail texture
+    ThumbnailTexture.Reset(SimpleAssetLibraryThumbnails::GetSharedLibraryThumbnailTexture(Entry.AssetData));
+
+    UTexture2D* Texture = ThumbnailTexture ? ThumbnailTexture.Get() : DefaultThumbnail;
+    ThumbnailBrush.SetResourceObject(Texture);
+    ThumbnailBrush.ImageSize = Texture ? FVector2D(Texture->GetSizeX(), Texture->GetSizeY()) : FVector2D::ZeroVector;
+}
+
+void
+SSimpleAssetLibraryTile::ClearEntry()
+{
+    ThumbnailBrush.SetResourceObject(nullptr);
+    ThumbnailTexture.Reset();
+    DisplayName = FText::GetEmpty();
+    PackageName = NAME_None;
+}
+
+void
+SSimpleAssetLibraryTile::SetTileSize(const FVector2D& Size)
+{
+    SizeBox->SetWidthOverride(Size.X);
+    SizeBox->SetHeightOverride(Size.Y);
+}
+
+FText
+SSimpleAssetLibraryTile::GetEntryToolTipText() const
+{
+    if (PackageName.IsNone()) {
+        return FText::GetEmpty();
+    }
+    return FText::Format(INVTEXT("{0}\n{1}"), DisplayName, USimpleAssetLibraryBPLibrary::GetLibraryEntryLoadSetText(PackageName));
+}
@@ -2,6 +2,13 @@
 
 #include "SimpleAssetLibraryBPLibrary.h"
 #include "SimpleAssetLibrary.h"
+#include "SimpleAssetLibraryFavorites.h"
+#include "SimpleAssetLibraryIndex.h"
+#include "SimpleAssetLibraryLoadSets.h"
+#include "SimpleAssetLibraryMaterialPool.h"
+#include "SimpleAssetLibraryQueryArena.h"
+#include "SimpleAssetLibraryThumbnailCache.h"
+#include "SimpleAssetLibraryUsage.h"
 
 
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -20,6 +27,7 @@
 #include "TextureResource.h"
 #include "ObjectTools.h"
 #include "UObject/SoftObjectPath.h"
+#include "Misc/PackageName.h"
 #include "Materials/MaterialInstanceDynamic.h"
 
 
@@ -106,38 +114,13 @@ USimpleAssetLibraryBPLibrary::AddExistingAssetThumbnailToDynamicMaterial(
      * https://forums.unrealengine.com/t/getting-asset-thumbnails-as-a-texture2d/1180079/2
      */
 
-    FString PackageFilename;
-    const FName ObjectFullName = FName(*AssetData.GetFullName());
-    TSet<FName> ObjectFullNames;
-    ObjectFullNames.Add(ObjectFullName);
-
-    if (AssetData.PackageName.ToString() != "None" && FPackageName::DoesPackageExist(AssetData.PackageName.ToString(), &PackageFilename))
-    {
-        FThumbnailMap ThumbnailMap;
-        ThumbnailTools::LoadThumbnailsFromPackage(PackageFilename, ObjectFullNames, ThumbnailMap);
-        FObjectThumbnail* Thumbnail = ThumbnailMap.Find(ObjectFullName);
-
-        IImageWrapperModule& ImageWrapperModule = FModuleManager::Get().LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
-        TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
-
-        ImageWidth = Thumbnail->GetImageWidth();
-        ImageHeight = Thumbnail->GetImageHeight();
-
-        ImageWrapper->SetRaw(
-            Thumbnail->GetUncompressedImageData().GetData(),
-            Thumbnail->GetUncompressedImageData().Num(),
-            ImageWidth,
-            ImageHeight,
-            ERGBFormat::BGRA, 8
-        );
-
-        const TArray64<uint8>& CompressedByteArray = ImageWrapper->GetCompressed();
-        UTexture2D* ThumbnailTexture = FImageUtils::ImportBufferAsTexture2D(CompressedByteArray);
-        DynamicMaterial->SetTextureParameterValue("texture", ThumbnailTexture);
-    }
-    else{
-        DynamicMaterial->SetTextureParameterValue("texture", DefaultTexture);
+    // the widgets of entries with identical thumbnails show the same texture
+    UTexture2D* ThumbnailTexture = SimpleAssetLibraryThumbnails::GetSharedLibraryThumbnailTexture(AssetData);
+    if (ThumbnailTexture) {
+        ImageWidth = ThumbnailTexture->GetSizeX();
+        ImageHeight = ThumbnailTexture->GetSizeY();
     }
+    FSimpleAssetLibraryMaterialPool::Get().SetThumbnailTexture(DynamicMaterial, ThumbnailTexture ? ThumbnailTexture : DefaultTexture);
 }
 
 void
@@ -184,65 +167,405 @@ USimpleAssetLibraryBPLibrary::RenderAssetThumbnailToDynamicMaterial(
             IsValid = false;
         }
 
-        // Prepare the transient texture
-        UTexture2D* ThumbnailTexture = UTexture2D::CreateTransient(ImageWidth, ImageHeight, PF_B8G8R8A8);
-        if (ThumbnailTexture == nullptr) {
-            IsValid = false;
+        // If everything is valid, upload the thumbnail into a transient texture
+        // the package keeps its thumbnail, the pixels are copied once and moved to the render thread from there.
+        // The texture is kept alive by the material
+        UTexture2D* ThumbnailTexture = nullptr;
+        if (IsValid) {
+            TArray<uint8> Pixels(thumb->GetUncompressedImageData());
+            ThumbnailTexture = SimpleAssetLibraryThumbnails::CreateThumbnailTexture(MoveTemp(Pixels), ImageWidth, ImageHeight);
+            IsValid = ThumbnailTexture != nullptr;
         }
-
-        // If everything is valid, Populate the thumbnail into the transient texture
         if (IsValid) {
-            uint8* MipData = (uint8*)ThumbnailTexture->GetPlatformData()->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
-            TArray<uint8> RawData = thumb->GetUncompressedImageData();
-            FMemory::Memcpy(MipData, RawData.GetData(), RawData.Num());
-
-            ThumbnailTexture->bNotOfflineProcessed = true;
-            ThumbnailTexture->GetPlatformData()->Mips[0].BulkData.Unlock();
-            ThumbnailTexture->UpdateResource();
-            ThumbnailTexture->AddToRoot();
-
             // apply the texture to dynamic material
-            DynamicMaterial->SetTextureParameterValue("texture", ThumbnailTexture);
+            FSimpleAssetLibraryMaterialPool::Get().SetThumbnailTexture(DynamicMaterial, ThumbnailTexture);
             return;
         }
 
     }
 
     // If any issues were encountered, try to get the existing default thumbnail for the asset instead
-    const FName ObjectFullName = FName(*AssetData.GetFullName());
-    TSet<FName> ObjectFullNames;
-    ObjectFullNames.Add(ObjectFullName);
-
     // If the asset exists, get its existing static thumbnail
-    if (AssetData.PackageName.ToString() != "None" && FPackageName::DoesPackageExist(AssetData.PackageName.ToString(), &PackageFilename))
+    TArray64<uint8> CompressedByteArray;
+    if (SimpleAssetLibraryThumbnails::LoadCompressedPackageThumbnail(AssetData, CompressedByteArray, ImageWidth, ImageHeight))
     {
-        FThumbnailMap ThumbnailMap;
-        ThumbnailTools::LoadThumbnailsFromPackage(PackageFilename, ObjectFullNames, ThumbnailMap);
-        FObjectThumbnail* DefaultThumb = ThumbnailMap.Find(ObjectFullName);
-
-        IImageWrapperModule& ImageWrapperModule = FModuleManager::Get().LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
-        TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
-
-        ImageWidth = DefaultThumb->GetImageWidth();
-        ImageHeight = DefaultThumb->GetImageHeight();
-
-        ImageWrapper->SetRaw(
-            DefaultThumb->GetUncompressedImageData().GetData(),
-            DefaultThumb->GetUncompressedImageData().Num(),
-            ImageWidth,
-            ImageHeight,
-            ERGBFormat::BGRA, 8
-        );
-
-        const TArray64<uint8>& CompressedByteArray = ImageWrapper->GetCompressed();
         UTexture2D* ThumbnailTexture = FImageUtils::ImportBufferAsTexture2D(CompressedByteArray);
-        DynamicMaterial->SetTextureParameterValue("texture", ThumbnailTexture);
+        FSimpleAssetLibraryMaterialPool::Get().SetThumbnailTexture(DynamicMaterial, ThumbnailTexture);
         IsValid = true;
         return;
     }
 
     // Final fallback, use the provided default texture if the asset appears invalid
-    DynamicMaterial->SetTextureParameterValue("texture", DefaultTexture);
+    FSimpleAssetLibraryMaterialPool::Get().SetThumbnailTexture(DynamicMaterial, DefaultTexture);
+}
+
+UMaterialInstanceDynamic*
+USimpleAssetLibraryBPLibrary::AcquireThumbnailMaterial(UMaterialInterface* Parent)
+{
+    return FSimpleAssetLibraryMaterialPool::Get().Acquire(Parent);
+}
+
+void
+USimpleAssetLibraryBPLibrary::ReleaseThumbnailMaterial(UMaterialInstanceDynamic* DynamicMaterial)
+{
+    FSimpleAssetLibraryMaterialPool::Get().Release(DynamicMaterial);
+}
+
+namespace
+{
+    const FSimpleAssetLibraryNameTable& GetMetadataNameTable(ESimpleAssetLibraryMetadata Metadata)
+    {
+        const FSimpleAssetLibraryNames& Names = FSimpleAssetLibraryIndex::Get().GetNames();
+        switch (Metadata)
+        {
+        case ESimpleAssetLibraryMetadata::Category:
+            return Names.Categories;
+        case ESimpleAssetLibraryMetadata::AddedBy:
+            return Names.Authors;
+        default:
+            return Names.AssetTypes;
+        }
+    }
+
+    // The scratch memory of the queries made from Python and Blueprints, the library panels have their own
+    FSimpleAssetLibraryQueryArena& GetScriptQueryArena()
+    {
+        return FSimpleAssetLibraryModule::Get().GetScriptQueryArena();
+    }
+
+    // Fill the library data of a row from the index columns, the asset data is built from the stored paths
+    void MakeEntryInfo(const FSimpleAssetLibraryIndex& Index, int32 Row, FSimpleAssetLibraryEntryInfo& OutInfo)
+    {
+        const FSimpleAssetLibraryEntryStore& Store = Index.GetStore();
+        const FSimpleAssetLibraryNames& Names = Store.GetNames();
+        const FSoftObjectPath& ObjectPath = Store.GetObjectPaths()[Row];
+        const FTopLevelAssetPath& AssetClassPath = Store.GetAssetClassPaths()[Row];
+
+        OutInfo.Handle.Row = Row;
+        OutInfo.Handle.Serial = Store.GetSerial();
+        const FName PackageName = Store.GetPackageNames()[Row];
+        const FName PackagePath(*FPackageName::GetLongPackagePath(PackageName.ToString()));
+        OutInfo.AssetData = FAssetData(PackageName, PackagePath, ObjectPath.GetAssetFName(), AssetClassPath);
+        OutInfo.DisplayName = Store.GetDisplayNames()[Row];
+        OutInfo.AssetType = Names.AssetTypes.GetName(Store.GetAssetTypeIds()[Row]);
+        OutInfo.Category = Names.Categories.GetName(Store.GetCategoryIds()[Row]);
+        OutInfo.AddedBy = Names.Authors.GetName(Store.GetAddedByIds()[Row]);
+        OutInfo.UnrealClass = AssetClassPath.GetAssetName();
+    }
+
+    TArray<FSimpleAssetLibraryEntryHandle> MakeEntryHandles(const FSimpleAssetLibraryIndex& Index, TConstArrayView<int32> Rows)
+    {
+        TArray<FSimpleAssetLibraryEntryHandle> Handles;
+        Handles.SetNum(Rows.Num());
+        for (int32 HandleIndex = 0; HandleIndex < Rows.Num(); HandleIndex++)
+        {
+            Handles[HandleIndex].Row = Rows[HandleIndex];
+            Handles[HandleIndex].Serial = Index.GetStore().GetSerial();
+        }
+        return Handles;
+    }
+
+    TArray<FSimpleAssetLibraryEntryInfo> MakeEntryInfos(const FSimpleAssetLibraryIndex& Index, TConstArrayView<int32> Rows)
+    {
+        TArray<FSimpleAssetLibraryEntryInfo> Infos;
+        Infos.SetNum(Rows.Num());
+        for (int32 InfoIndex = 0; InfoIndex < Rows.Num(); InfoIndex++)
+        {
+            MakeEntryInfo(Index, Rows[InfoIndex], Infos[InfoIndex]);
+        }
+        return Infos;
+    }
+
+    // The entries of the given packages that are in the library, found by package rather than queried
+    TArray<FSimpleAssetLibraryEntryInfo> MakePackageEntryInfos(const FSimpleAssetLibraryIndex& Index, TConstArrayView<FName> PackageNames)
+    {
+        TArray<FSimpleAssetLibraryEntryInfo> Infos;
+        Infos.Reserve(PackageNames.Num());
+        for (const FName PackageName : PackageNames)
+        {
+            const int32 Row = Index.GetStore().Find(PackageName);
+            if (Row != INDEX_NONE) {
+                MakeEntryInfo(Index, Row, Infos.AddDefaulted_GetRef());
+            }
+        }
+        return Infos;
+    }
+}
+
+TArray<FAssetData>
+USimpleAssetLibraryBPLibrary::QueryLibraryAssets(FName AssetType, FName Category)
+{
+    FSimpleAssetLibraryIndex& Index = FSimpleAssetLibraryIndex::Get();
+    FSimpleAssetLibraryQueryArena& Arena = GetScriptQueryArena();
+    Arena.Reset();
+    const TArrayView<int32> Rows = Index.Query(AssetType, Category, Arena);
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    TArray<FAssetData> Assets;
+    Assets.Reserve(Rows.Num());
+    for (int32 Row : Rows)
+    {
+        FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(Index.GetStore().GetObjectPaths()[Row]);
+        if (AssetData.IsValid()) {
+            Assets.Add(MoveTemp(AssetData));
+        }
+    }
+    return Assets;
+}
+
+TArray<FSimpleAssetLibraryEntryHandle>
+USimpleAssetLibraryBPLibrary::GetLibraryEntryHandles(FName AssetType, FName Category)
+{
+    FSimpleAssetLibraryIndex& Index = FSimpleAssetLibraryIndex::Get();
+    FSimpleAssetLibraryQueryArena& Arena = GetScriptQueryArena();
+    Arena.Reset();
+    return MakeEntryHandles(Index, Index.Query(AssetType, Category, Arena));
+}
+
+bool
+USimpleAssetLibraryBPLibrary::GetLibraryEntryInfo(const FSimpleAssetLibraryEntryHandle& Handle, FSimpleAssetLibraryEntryInfo& Info)
+{
+    const FSimpleAssetLibraryIndex& Index = FSimpleAssetLibraryIndex::Get();
+    if (Handle.Serial != Index.GetStore().GetSerial() || Handle.Row < 0 || Handle.Row >= Index.GetStore().Num()) {
+        return false;
+    }
+    MakeEntryInfo(Index, Handle.Row, Info);
+    return true;
+}
+
+TArray<FSimpleAssetLibraryEntryInfo>
+USimpleAssetLibraryBPLibrary::GetLibraryEntryInfos(FName AssetType, FName Category)
+{
+    FSimpleAssetLibraryIndex& Index = FSimpleAssetLibraryIndex::Get();
+    FSimpleAssetLibraryQueryArena& Arena = GetScriptQueryArena();
+    Arena.Reset();
+    return MakeEntryInfos(Index, Index.Query(AssetType, Category, Arena));
+}
+
+TArray<FSimpleAssetLibraryEntryHandle>
+USimpleAssetLibraryBPLibrary::FilterLibraryEntryHandles(const FSimpleAssetLibraryFilter& Filter)
+{
+    FSimpleAssetLibraryIndex& Index = FSimpleAssetLibraryIndex::Get();
+    FSimpleAssetLibraryQueryArena& Arena = GetScriptQueryArena();
+    Arena.Reset();
+    return MakeEntryHandles(Index, Index.Query(Filter, Arena));
+}
+
+TArray<FSimpleAssetLibraryEntryInfo>
+USimpleAssetLibraryBPLibrary::FilterLibraryEntryInfos(const FSimpleAssetLibraryFilter& Filter)
+{
+    FSimpleAssetLibraryIndex& Index = FSimpleAssetLibraryIndex::Get();
+    FSimpleAssetLibraryQueryArena& Arena = GetScriptQueryArena();
+    Arena.Reset();
+    return MakeEntryInfos(Index, Index.Query(Filter, Arena));
+}
+
+int32
+USimpleAssetLibraryBPLibrary::CountLibraryEntries(const FSimpleAssetLibraryFilter& Filter)
+{
+    FSimpleAssetLibraryQueryArena& Arena = GetScriptQueryArena();
+    Arena.Reset();
+    return FSimpleAssetLibraryIndex::Get().Count(Filter, Arena);
+}
+
+TArray<int32>
+USimpleAssetLibraryBPLibrary::CountLibraryEntriesByValue(const FSimpleAssetLibraryFilter& Filter, ESimpleAssetLibraryFilterCriterion Criterion, TArray<FName>& Values)
+{
+    FSimpleAssetLibraryIndex& Index = FSimpleAssetLibraryIndex::Get();
+    FSimpleAssetLibraryQueryArena& Arena = GetScriptQueryArena();
+    Arena.Reset();
+    const TArrayView<int32> CountsById = Index.CountByValue(Filter, Criterion, Arena);
+
+    // skip the values no entry uses anymore, like the None value of the name tables
+    TArray<int32> Counts;
+    Values.Reset();
+    for (int32 ValueId = 0; ValueId < CountsById.Num(); ValueId++)
+    {
+        const FName Value = Index.GetCriterionValue(Criterion, ValueId);
+        if (!Value.IsNone()) {
+            Values.Add(Value);
+            Counts.Add(CountsById[ValueId]);
+        }
+    }
+    return Counts;
+}
+
+TArray<FName>
+USimpleAssetLibraryBPLibrary::GetLibraryCategories(FName AssetType, TArray<int32>& CategoryIds)
+{
+    FSimpleAssetLibraryIndex& Index = FSimpleAssetLibraryIndex::Get();
+    FSimpleAssetLibraryQueryArena& Arena = GetScriptQueryArena();
+    Arena.Reset();
+    CategoryIds = TArray<int32>(Index.GetCategoryIds(AssetType, Arena));
+
+    TArray<FName> Categories;
+    Categories.Reserve(CategoryIds.Num());
+    for (int32 CategoryId : CategoryIds)
+    {
+        Categories.Add(Index.GetNames().Categories.GetName(CategoryId));
+    }
+    return Categories;
+}
+
+TArray<FName>
+USimpleAssetLibraryBPLibrary::GetLibraryMetadataValues(ESimpleAssetLibraryMetadata Metadata)
+{
+    return GetMetadataNameTable(Metadata).GetNames();
+}
+
+int32
+USimpleAssetLibraryBPLibrary::GetLibraryMetadataId(ESimpleAssetLibraryMetadata Metadata, FName Value)
+{
+    return GetMetadataNameTable(Metadata).Find(Value);
+}
+
+void
+USimpleAssetLibraryBPLibrary::RefreshLibraryEntry(FName PackageName)
+{
+    FSimpleAssetLibraryIndex::Get().RefreshPackage(PackageName);
+}
+
+void
+USimpleAssetLibraryBPLibrary::RebuildLibraryIndex()
+{
+    FSimpleAssetLibraryIndex::Get().Rebuild();
+}
+
+bool
+USimpleAssetLibraryBPLibrary::GetLibraryDiscoveryProgress(float& Progress)
+{
+    const FSimpleAssetLibraryIndex& Index = FSimpleAssetLibraryIndex::Get();
+    Progress = Index.GetDiscoveryProgress();
+    return Index.IsDiscovering();
+}
+
+float
+USimpleAssetLibraryBPLibrary::GetLibraryThumbnailDedup(int32& NumEntries, int32& NumTextures)
+{
+    SimpleAssetLibraryThumbnails::GetSharedLibraryThumbnailTextureCounts(NumEntries, NumTextures);
+    return NumEntries > 0 ? 1.0f - static_cast<float>(NumTextures) / NumEntries : 0.0f;
+}
+
+void
+USimpleAssetLibraryBPLibrary::SetSharedLibraryPackDirectory(const FString& Directory)
+{
+    FSimpleAssetLibraryModule::Get().SetSharedPackDirectory(Directory);
+}
+
+bool
+USimpleAssetLibraryBPLibrary::ExportSharedLibraryPack(const FString& Directory)
+{
+    return FSimpleAssetLibraryIndex::Get().ExportSharedPack(Directory);
+}
+
+void
+USimpleAssetLibraryBPLibrary::GetLibraryEntryLoadSet(FName PackageName, int32& NumDependencies, int64& DiskSize)
+{
+    const FSimpleAssetLibraryLoadSet& LoadSet = FSimpleAssetLibraryLoadSets::Get().GetLoadSet(PackageName);
+    NumDependencies = LoadSet.NumDependencies();
+    DiskSize = LoadSet.DiskSize;
+}
+
+FText
+USimpleAssetLibraryBPLibrary::GetLibraryEntryLoadSetText(FName PackageName)
+{
+    const FSimpleAssetLibraryLoadSet& LoadSet = FSimpleAssetLibraryLoadSets::Get().GetLoadSet(PackageName);
+    return FText::Format(
+        NSLOCTEXT("SimpleAssetLibrary", "LoadSet", "Loads {0} {0}|plural(one=dependency,other=dependencies), {1} on disk"),
+        FText::AsNumber(LoadSet.NumDependencies()),
+        FText::AsMemory(LoadSet.DiskSize)
+    );
+}
+
+bool
+USimpleAssetLibraryBPLibrary::PrefetchLibraryEntry(FName PackageName)
+{
+    const FSimpleAssetLibraryEntryStore& Store = FSimpleAssetLibraryIndex::Get().GetStore();
+    const int32 Row = Store.Find(PackageName);
+    return Row != INDEX_NONE && FSimpleAssetLibraryLoadSets::Get().Prefetch(Store.GetObjectPaths()[Row]);
+}
+
+bool
+USimpleAssetLibraryBPLibrary::IsLibraryEntryPrefetched(FName PackageName)
+{
+    const FSimpleAssetLibraryEntryStore& Store = FSimpleAssetLibraryIndex::Get().GetStore();
+    const int32 Row = Store.Find(PackageName);
+    return Row != INDEX_NONE && FSimpleAssetLibraryLoadSets::Get().IsPrefetched(Store.GetObjectPaths()[Row]);
+}
+
+TArray<FSimpleAssetLibraryEntryInfo>
+USimpleAssetLibraryBPLibrary::GetRecentLibraryEntries()
+{
+    return MakePackageEntryInfos(FSimpleAssetLibraryIndex::Get(), FSimpleAssetLibraryFavorites::Get().GetRecent());
+}
+
+TArray<FSimpleAssetLibraryEntryInfo>
+USimpleAssetLibraryBPLibrary::GetFavoriteLibraryEntries()
+{
+    return MakePackageEntryInfos(FSimpleAssetLibraryIndex::Get(), FSimpleAssetLibraryFavorites::Get().GetFavorites());
+}
+
+void
+USimpleAssetLibraryBPLibrary::SetLibraryEntryFavorite(FName PackageName, bool bFavorite)
+{
+    FSimpleAssetLibraryFavorites::Get().SetFavorite(PackageName, bFavorite);
+}
+
+bool
+USimpleAssetLibraryBPLibrary::IsLibraryEntryFavorite(FName PackageName)
+{
+    return FSimpleAssetLibraryFavorites::Get().IsFavorite(PackageName);
+}
+
+void
+USimpleAssetLibraryBPLibrary::ClearRecentLibraryEntries()
+{
+    FSimpleAssetLibraryFavorites::Get().ClearRecent();
+}
+
+bool
+USimpleAssetLibraryBPLibrary::GetLibraryEntryUsage(FName PackageName, int32& SpawnCount, FDateTime& LastUsed, float& AverageLatencyMs)
+{
+    const FSimpleAssetLibraryEntryUsage* Usage = FSimpleAssetLibraryUsage::Get().Find(PackageName);
+    if (Usage == nullptr) {
+        SpawnCount = 0;
+        LastUsed = FDateTime();
+        AverageLatencyMs = 0.0f;
+        return false;
+    }
+    SpawnCount = Usage->SpawnCount;
+    LastUsed = Usage->LastUsed;
+    AverageLatencyMs = static_cast<float>(Usage->GetAverageLatencyMs());
+    return true;
+}
+
+TArray<FSimpleAssetLibraryEntryInfo>
+USimpleAssetLibraryBPLibrary::GetMostUsedLibraryEntries(int32 MaxEntries)
+{
+    // entries no longer in the library are skipped, ask for more so there are still MaxEntries left
+    FSimpleAssetLibraryIndex& Index = FSimpleAssetLibraryIndex::Get();
+    TArray<FSimpleAssetLibraryEntryInfo> Infos = MakePackageEntryInfos(Index, FSimpleAssetLibraryUsage::Get().GetMostUsed(MAX_int32));
+    if (Infos.Num() > MaxEntries) {
+        Infos.SetNum(FMath::Max(MaxEntries, 0));
+    }
+    return Infos;
+}
+
+TArray<FSimpleAssetLibraryEntryInfo>
+USimpleAssetLibraryBPLibrary::GetUnusedLibraryEntries()
+{
+    FSimpleAssetLibraryIndex& Index = FSimpleAssetLibraryIndex::Get();
+    const FSimpleAssetLibraryUsage& Usage = FSimpleAssetLibraryUsage::Get();
+    const TArray<FName>& PackageNames = Index.GetStore().GetPackageNames();
+
+    TArray<FSimpleAssetLibraryEntryInfo> Infos;
+    for (int32 Row = 0; Row < PackageNames.Num(); Row++)
+    {
+        if (Usage.Find(PackageNames[Row]) == nullptr) {
+            MakeEntryInfo(Index, Row, Infos.AddDefaulted_GetRef());
+        }
+    }
+    return Infos;
 }
 
 void
@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SimpleAssetLibraryFavorites.h"
+#include "SimpleAssetLibrary.h"
+#include "SimpleAssetLibraryBPLibrary.h"
+#include "SimpleAssetLibraryThumbnailCache.h"
+
+#include "Engine/Texture2D.h"
+
+
+namespace
+{
+    // Number of recently placed entries kept, the older ones are dropped
+    constexpr int32 MaxRecent = 24;
+
+    // The keys of the lists in the user settings file
+    const TCHAR* RecentKey = TEXT("recent_entries");
+    const TCHAR* FavoritesKey = TEXT("favorite_entries");
+}
+
+
+FSimpleAssetLibraryFavorites::FSimpleAssetLibraryFavorites()
+{
+    FSimpleAssetLibraryPrefsStore& PrefsStore = FSimpleAssetLibraryPrefsStore::Get();
+    Recent = PrefsStore.GetNames(RecentKey);
+    Favorites = PrefsStore.GetNames(FavoritesKey);
+    UpdatePins();
+
+    // the lists are loaded before the index found all their entries, the others are pinned when they're added
+    EntriesChangedHandle = FSimpleAssetLibraryIndex::Get().OnEntriesChanged().AddRaw(this, &FSimpleAssetLibraryFavorites::HandleEntriesChanged);
+}
+
+FSimpleAssetLibraryFavorites::~FSimpleAssetLibraryFavorites()
+{
+    FSimpleAssetLibraryIndex::Get().OnEntriesChanged().Remove(EntriesChangedHandle);
+}
+
+FSimpleAssetLibraryFavorites&
+FSimpleAssetLibraryFavorites::Get()
+{
+    return FSimpleAssetLibraryModule::Get().GetFavorites();
+}
+
+void
+FSimpleAssetLibraryFavorites::AddRecent(FName PackageName)
+{
+    if (PackageName.IsNone() || (Recent.Num() > 0 && Recent[0] == PackageName)) {
+        return;
+    }
+    Recent.Remove(PackageName);
+    Recent.Insert(PackageName, 0);
+    if (Recent.Num() > MaxRecent) {
+        Recent.SetNum(MaxRecent);
+    }
+    FSimpleAssetLibraryPrefsStore::Get().SetNames(RecentKey, Recent);
+    UpdatePins();
+}
+
+void
+FSimpleAssetLibraryFavorites::SetFavorite(FName PackageName, bool bFavorite)
+{
+    if (PackageName.IsNone() || IsFavorite(PackageName) == bFavorite) {
+        return;
+    }
+    if (bFavorite) {
+        Favorites.Add(PackageName);
+    }
+    else {
+        Favorites.Remove(PackageName);
+    }
+    FSimpleAssetLibraryPrefsStore::Get().SetNames(FavoritesKey, Favorites);
+    UpdatePins();
+}
+
+void
+FSimpleAssetLibraryFavorites::ClearRecent()
+{
+    if (Recent.Num() > 0) {
+        Recent.Reset();
+        FSimpleAssetLibraryPrefsStore::Get().SetNames(RecentKey, Recent);
+        UpdatePins();
+    }
+}
+
+void
+FSimpleAssetLibraryFavorites::UpdatePins()
+{
+    const FSimpleAssetLibraryEntryStore& Store = FSimpleAssetLibraryIndex::Get().GetStore();
+    FSimpleAssetLibraryLoadSets& LoadSets = FSimpleAssetLibraryLoadSets::Get();
+
+    TSet<FName> Wanted(Favorites);
+    Wanted.Append(Recent);
+    for (auto It = Pinned.CreateIterator(); It; ++It)
+    {
+        if (!Wanted.Contains(It.Key())) {
+            LoadSets.Unpin(It.Value().AssetPath);
+            It.RemoveCurrent();
+        }
+    }
+
+    for (const FName PackageName : Wanted)
+    {
+        const int32 Row = Store.Find(PackageName);
+        if (Row == INDEX_NONE || Pinned.Contains(PackageName)) {
+            continue;
+        }
+        FSimpleAssetLibraryEntryHandle Handle;
+        Handle.Row = Row;
+        Handle.Serial = Store.GetSerial();
+        FSimpleAssetLibraryEntryInfo Info;
+        if (!USimpleAssetLibraryBPLibrary::GetLibraryEntryInfo(Handle, Info)) {
+            continue;
+        }
+        FPinnedEntry& Entry = Pinned.Add(PackageName);
+        Entry.AssetPath = Store.GetObjectPaths()[Row];
+        Entry.Thumbnail.Reset(SimpleAssetLibraryThumbnails::GetSharedLibraryThumbnailTexture(Info.AssetData));
+        LoadSets.Pin(Entry.AssetPath);
+    }
+}
+
+void
+FSimpleAssetLibraryFavorites::HandleEntriesChanged()
+{
+    UpdatePins();
+}
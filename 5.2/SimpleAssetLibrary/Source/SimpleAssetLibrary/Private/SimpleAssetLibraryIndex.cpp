@@ -0,0 +1,1052 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SimpleAssetLibraryIndex.h"
+#include "SimpleAssetLibrary.h"
+#include "SimpleAssetLibraryBPLibrary.h"
+#include "SimpleAssetLibraryFilterBits.h"
+#include "SimpleAssetLibraryManifest.h"
+#include "SimpleAssetLibraryNameSearch.h"
+#include "SimpleAssetLibraryPack.h"
+#include "SimpleAssetLibraryPackageScanner.h"
+#include "SimpleAssetLibraryQueryArena.h"
+#include "SimpleAssetLibraryStats.h"
+#include "SimpleAssetLibrarySubsystem.h"
+#include "SimpleAssetLibraryThumbnailCache.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/xxhash.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+
+namespace
+{
+    // Number of restored manifest entries validated against the Asset Registry per tick
+    constexpr int32 ValidationBatchSize = 256;
+
+    // The thumbnail cache is compacted when its unused images take this many bytes and a quarter of it
+    constexpr int64 MinCompactThumbnailBytes = 4 * 1024 * 1024;
+
+    IAssetRegistry& GetAssetRegistry()
+    {
+        return FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    }
+}
+
+
+FSimpleAssetLibraryIndex::FSimpleAssetLibraryIndex()
+: ThumbnailCache(MakeUnique<FSimpleAssetLibraryThumbnailCache>(GetThumbnailCacheFilename()))
+, NameSearch(MakeUnique<FSimpleAssetLibraryNameSearch>())
+, FilterBits(MakeUnique<FSimpleAssetLibraryFilterBits>())
+{}
+
+FSimpleAssetLibraryIndex::~FSimpleAssetLibraryIndex()
+{
+    if (ValidationTickerHandle.IsValid()) {
+        FTSTicker::GetCoreTicker().RemoveTicker(ValidationTickerHandle);
+    }
+    if (PendingTickerHandle.IsValid()) {
+        FTSTicker::GetCoreTicker().RemoveTicker(PendingTickerHandle);
+    }
+
+    // the Asset Registry may already be unloaded when the editor exits
+    if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry"))) {
+        IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+        AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+        AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+        AssetRegistry.OnInMemoryAssetDeleted().Remove(InMemoryAssetDeletedHandle);
+        AssetRegistry.OnAssetsAdded().Remove(AssetsDiscoveredHandle);
+        AssetRegistry.OnFileLoadProgressUpdated().Remove(DiscoveryProgressHandle);
+        AssetRegistry.OnFilesLoaded().Remove(FilesLoadedHandle);
+    }
+    if (DiscoveryNotification.IsValid()) {
+        DiscoveryNotification->ExpireAndFadeout();
+    }
+}
+
+FSimpleAssetLibraryIndex&
+FSimpleAssetLibraryIndex::Get()
+{
+    return FSimpleAssetLibraryModule::Get().GetIndex();
+}
+
+void
+FSimpleAssetLibraryIndex::Initialize()
+{
+    if (bInitialized) {
+        return;
+    }
+    bInitialized = true;
+
+    // follow the entries renamed, moved or deleted in the editor from now on
+    IAssetRegistry& AssetRegistry = GetAssetRegistry();
+    AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FSimpleAssetLibraryIndex::HandleAssetRenamed);
+    AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FSimpleAssetLibraryIndex::HandleAssetRemoved);
+    InMemoryAssetDeletedHandle = AssetRegistry.OnInMemoryAssetDeleted().AddRaw(this, &FSimpleAssetLibraryIndex::HandleInMemoryAssetDeleted);
+
+    const double StartTime = FPlatformTime::Seconds();
+    const bool bHasSharedPack = MountSharedPack();
+
+    // The local manifest is only usable if it was seeded from the pack that is mounted now
+    if (LoadManifest() && (!bHasSharedPack || SeedPackId == SharedPack->GetPackId())) {
+        UE_LOG(AssetLibrary, Log, TEXT("Restored %d Asset Library entries from the manifest in %.2f ms"),
+            Store.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+        StartValidation();
+        if (AssetRegistry.IsLoadingAssets()) {
+            StartDiscovery(false);
+        }
+        return;
+    }
+
+    // Without a manifest the cached thumbnail offsets are lost, start over with an empty cache
+    ThumbnailCache->Reset();
+
+    // Seed from the shared pack, the validation then only records the local changes
+    if (bHasSharedPack) {
+        Store = SharedPack->GetStore();
+        SeedPackId = SharedPack->GetPackId();
+        bDirty = true;
+
+        UE_LOG(AssetLibrary, Log, TEXT("Seeded %d Asset Library entries from the shared library pack in %.2f ms"),
+            Store.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+        StartValidation();
+        if (AssetRegistry.IsLoadingAssets()) {
+            StartDiscovery(false);
+        }
+        return;
+    }
+
+    // Don't wait for the registry, read the package headers from disk and add the assets it discovers meanwhile
+    SeedPackId.Invalidate();
+    if (AssetRegistry.IsLoadingAssets()) {
+        ScanPackages();
+        StartDiscovery(true);
+        return;
+    }
+    Rebuild();
+}
+
+void
+FSimpleAssetLibraryIndex::ScanPackages()
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    USimpleAssetLibrarySubsystem* Subsystem = USimpleAssetLibrarySubsystem::Get();
+    const TArray<FString> Roots = Subsystem ? Subsystem->GetLibraryScanRoots() : TArray<FString>{ TEXT("/Game/") };
+    TArray<FAssetData> Assets;
+    SimpleAssetLibraryPackageScanner::ScanRoots(Roots, Assets);
+    FindRegisteredAssets(Assets);
+
+    Store.Reset();
+    for (const FAssetData& AssetData : Assets)
+    {
+        FSimpleAssetLibraryEntry NewEntry;
+        if (Store.Find(AssetData.PackageName) == INDEX_NONE && FSimpleAssetLibraryEntry::FromAssetData(AssetData, Store.GetNames(), NewEntry)) {
+            NewEntry.Fingerprint = FSimpleAssetLibraryPackageFingerprint::FromPackage(NewEntry.PackageName, false);
+            Store.Add(MoveTemp(NewEntry));
+        }
+    }
+    Store.Sort();
+    bDirty = true;
+
+    // the manifest is only written once the registry confirmed the entries
+    UE_LOG(AssetLibrary, Log, TEXT("Indexed %d Asset Library entries from the package headers in %.2f ms"),
+        Store.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    EntriesChanged.Broadcast();
+}
+
+void
+FSimpleAssetLibraryIndex::Rebuild()
+{
+    if (ValidationTickerHandle.IsValid()) {
+        FTSTicker::GetCoreTicker().RemoveTicker(ValidationTickerHandle);
+        ValidationTickerHandle.Reset();
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    TArray<FAssetData> Assets;
+    FindRegisteredAssets(Assets);
+
+    // the current entries are only used for their thumbnails and fingerprints from here on
+    FSimpleAssetLibraryEntryStore NewStore;
+    int32 NumChanged = 0;
+    for (const FAssetData& AssetData : Assets)
+    {
+        FSimpleAssetLibraryEntry NewEntry;
+        if (!FSimpleAssetLibraryEntry::FromAssetData(AssetData, NewStore.GetNames(), NewEntry)) {
+            continue;
+        }
+
+        // keep the cached thumbnail of the packages that didn't change since they were indexed
+        const int32 ExistingRow = Store.Find(NewEntry.PackageName);
+        if (ExistingRow == INDEX_NONE) {
+            NewEntry.Fingerprint = FSimpleAssetLibraryPackageFingerprint::FromPackage(NewEntry.PackageName, false);
+        }
+        else if (Store.GetFingerprints()[ExistingRow].MatchesPackage(NewEntry.PackageName, NewEntry.Fingerprint)) {
+            NewEntry.CopyThumbnailFrom(Store.GetEntry(ExistingRow));
+        }
+        else {
+            NumChanged++;
+        }
+        NewStore.Add(MoveTemp(NewEntry));
+    }
+    NewStore.Sort();
+    Store = MoveTemp(NewStore);
+
+    UE_LOG(AssetLibrary, Log, TEXT("Indexed %d Asset Library entries from the Asset Registry, %d packages changed since they were indexed (%.2f ms)"),
+        Store.Num(), NumChanged, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+    bDirty = true;
+    SaveManifest();
+    EntriesChanged.Broadcast();
+}
+
+void
+FSimpleAssetLibraryIndex::RefreshPackage(FName PackageName)
+{
+    if (bInitialized && UpdatePackage(PackageName)) {
+        FinishUpdate();
+    }
+}
+
+bool
+FSimpleAssetLibraryIndex::UpdatePackage(FName PackageName)
+{
+    TArray<FAssetData> Assets;
+    GetAssetRegistry().GetAssetsByPackageName(PackageName, Assets);
+
+    FSimpleAssetLibraryEntry NewEntry;
+    bool bIsManaged = false;
+    for (const FAssetData& AssetData : Assets)
+    {
+        if (FSimpleAssetLibraryEntry::FromAssetData(AssetData, Store.GetNames(), NewEntry)) {
+            bIsManaged = true;
+            break;
+        }
+    }
+
+    const int32 ExistingRow = Store.Find(PackageName);
+    if (ExistingRow != INDEX_NONE && bIsManaged) {
+        const bool bSamePackage = Store.GetFingerprints()[ExistingRow].MatchesPackage(PackageName, NewEntry.Fingerprint);
+        if (Store.GetEntry(ExistingRow).HasSameLibraryData(NewEntry)) {
+            if (bSamePackage) {
+                return false;
+            }
+            // saved again with the same library data, only the cached thumbnail may be outdated
+            Store.SetFingerprint(ExistingRow, NewEntry.Fingerprint);
+            Store.SetThumbnail(ExistingRow, FSimpleAssetLibraryThumbnailRef(), false);
+            SimpleAssetLibraryThumbnails::ForgetSharedLibraryThumbnailTexture(PackageName);
+            return true;
+        }
+        // the asset was saved again, its cached thumbnail may be outdated too
+        Store.Set(ExistingRow, MoveTemp(NewEntry));
+    }
+    else if (ExistingRow != INDEX_NONE) {
+        Store.RemoveAt(ExistingRow);
+    }
+    else if (bIsManaged) {
+        NewEntry.Fingerprint = FSimpleAssetLibraryPackageFingerprint::FromPackage(PackageName, false);
+        Store.Add(MoveTemp(NewEntry));
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+void
+FSimpleAssetLibraryIndex::FinishUpdate()
+{
+    if (ValidationTickerHandle.IsValid()) {
+        InvalidEntries.Init(false, Store.Num());
+        ValidationCursor = 0;
+    }
+    Store.Sort();
+    bDirty = true;
+    EntriesChanged.Broadcast();
+}
+
+void
+FSimpleAssetLibraryIndex::StartDiscovery(bool bPopulate)
+{
+    bDiscovering = true;
+    DiscoveryProgress = 0.0f;
+    NumDiscoveredEntries = 0;
+
+    IAssetRegistry& AssetRegistry = GetAssetRegistry();
+    if (bPopulate) {
+        AssetsDiscoveredHandle = AssetRegistry.OnAssetsAdded().AddRaw(this, &FSimpleAssetLibraryIndex::HandleAssetsDiscovered);
+    }
+    DiscoveryProgressHandle = AssetRegistry.OnFileLoadProgressUpdated().AddRaw(this, &FSimpleAssetLibraryIndex::HandleDiscoveryProgress);
+    FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddRaw(this, &FSimpleAssetLibraryIndex::HandleFilesLoaded);
+
+    FNotificationInfo Info(FText::GetEmpty());
+    Info.bFireAndForget = false;
+    Info.bUseThrobber = true;
+    Info.ExpireDuration = 2.0f;
+    DiscoveryNotification = FSlateNotificationManager::Get().AddNotification(Info);
+    if (DiscoveryNotification.IsValid()) {
+        DiscoveryNotification->SetCompletionState(SNotificationItem::CS_Pending);
+    }
+    UpdateDiscoveryNotification();
+
+    UE_LOG(AssetLibrary, Log, TEXT("The Asset Registry is still discovering assets, %s"),
+        bPopulate ? TEXT("the Asset Library entries are added as they're discovered") : TEXT("the restored Asset Library entries are validated once it's done"));
+}
+
+void
+FSimpleAssetLibraryIndex::HandleAssetsDiscovered(TConstArrayView<FAssetData> Assets)
+{
+    // the registry adds the discovered assets in batches, the store is sorted and the windows notified once per batch
+    int32 NumAdded = 0;
+    for (const FAssetData& AssetData : Assets)
+    {
+        FSimpleAssetLibraryEntry NewEntry;
+        if (Store.Find(AssetData.PackageName) == INDEX_NONE && FSimpleAssetLibraryEntry::FromAssetData(AssetData, Store.GetNames(), NewEntry)) {
+            NewEntry.Fingerprint = FSimpleAssetLibraryPackageFingerprint::FromPackage(NewEntry.PackageName, false);
+            Store.Add(MoveTemp(NewEntry));
+            NumAdded++;
+        }
+    }
+    if (NumAdded > 0) {
+        NumDiscoveredEntries += NumAdded;
+        FinishUpdate();
+        UpdateDiscoveryNotification();
+    }
+}
+
+void
+FSimpleAssetLibraryIndex::HandleDiscoveryProgress(const IAssetRegistry::FFileLoadProgressUpdateData& ProgressData)
+{
+    if (ProgressData.NumTotalAssets > 0) {
+        DiscoveryProgress = FMath::Clamp(static_cast<float>(ProgressData.NumAssetsProcessedByAssetRegistry) / ProgressData.NumTotalAssets, 0.0f, 1.0f);
+    }
+    UpdateDiscoveryNotification();
+}
+
+void
+FSimpleAssetLibraryIndex::HandleFilesLoaded()
+{
+    const bool bPopulated = AssetsDiscoveredHandle.IsValid();
+    IAssetRegistry& AssetRegistry = GetAssetRegistry();
+    AssetRegistry.OnAssetsAdded().Remove(AssetsDiscoveredHandle);
+    AssetRegistry.OnFileLoadProgressUpdated().Remove(DiscoveryProgressHandle);
+    AssetRegistry.OnFilesLoaded().Remove(FilesLoadedHandle);
+    AssetsDiscoveredHandle.Reset();
+    DiscoveryProgressHandle.Reset();
+    FilesLoadedHandle.Reset();
+    bDiscovering = false;
+
+    // the registry has the last word: drop the scanned entries it doesn't know and add the ones it updated rather than added
+    if (bPopulated) {
+        TArray<FAssetData> Assets;
+        FindRegisteredAssets(Assets);
+
+        TSet<FName> RegisteredPackages;
+        RegisteredPackages.Reserve(Assets.Num());
+        for (const FAssetData& AssetData : Assets)
+        {
+            RegisteredPackages.Add(AssetData.PackageName);
+        }
+        TBitArray<> UnregisteredEntries(false, Store.Num());
+        int32 NumUnregistered = 0;
+        for (int32 Row = 0; Row < Store.Num(); Row++)
+        {
+            if (!RegisteredPackages.Contains(Store.GetPackageNames()[Row])) {
+                UnregisteredEntries[Row] = true;
+                NumUnregistered++;
+            }
+        }
+        if (NumUnregistered > 0) {
+            Store.Remove(UnregisteredEntries);
+            FinishUpdate();
+        }
+
+        HandleAssetsDiscovered(Assets);
+        SaveManifest();
+    }
+    UE_LOG(AssetLibrary, Log, TEXT("The Asset Registry finished discovering assets, %d Asset Library entries (%d added during the discovery)"),
+        Store.Num(), NumDiscoveredEntries);
+
+    if (DiscoveryNotification.IsValid()) {
+        DiscoveryNotification->SetText(FText::Format(NSLOCTEXT("SimpleAssetLibrary", "DiscoveryDone", "Asset Library ready: {0} entries"), FText::AsNumber(Store.Num())));
+        DiscoveryNotification->SetCompletionState(SNotificationItem::CS_Success);
+        DiscoveryNotification->ExpireAndFadeout();
+        DiscoveryNotification.Reset();
+    }
+}
+
+void
+FSimpleAssetLibraryIndex::UpdateDiscoveryNotification()
+{
+    if (DiscoveryNotification.IsValid()) {
+        DiscoveryNotification->SetText(FText::Format(NSLOCTEXT("SimpleAssetLibrary", "Discovering", "Asset Library: discovering assets {0}, {1} entries found"),
+            FText::AsPercent(DiscoveryProgress), FText::AsNumber(Store.Num())));
+    }
+}
+
+void
+FSimpleAssetLibraryIndex::HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    // the tags don't change with a rename, only the assets already in the library are affected
+    const FName OldPackageName(*FPackageName::ObjectPathToPackageName(OldObjectPath));
+    const int32 OldRow = Store.Find(OldPackageName);
+    if (OldRow == INDEX_NONE) {
+        return;
+    }
+    if (OldPackageName != AssetData.PackageName) {
+        RenamedEntries.Add(AssetData.PackageName, Store.GetEntry(OldRow));
+        QueuePackage(OldPackageName, true);
+    }
+    QueuePackage(AssetData.PackageName, false);
+}
+
+void
+FSimpleAssetLibraryIndex::HandleAssetRemoved(const FAssetData& AssetData)
+{
+    if (Store.Find(AssetData.PackageName) != INDEX_NONE) {
+        QueuePackage(AssetData.PackageName, true);
+    }
+}
+
+void
+FSimpleAssetLibraryIndex::HandleInMemoryAssetDeleted(UObject* Object)
+{
+    if (Object == nullptr || !Object->IsAsset()) {
+        return;
+    }
+    const FName PackageName = Object->GetPackage()->GetFName();
+    if (Store.Find(PackageName) != INDEX_NONE) {
+        QueuePackage(PackageName, true);
+    }
+}
+
+void
+FSimpleAssetLibraryIndex::QueuePackage(FName PackageName, bool bRemove)
+{
+    // a folder move renames every asset in it one after the other, they're patched together on the next tick
+    PendingPackages.Add(PackageName, bRemove);
+    if (!PendingTickerHandle.IsValid()) {
+        PendingTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateRaw(this, &FSimpleAssetLibraryIndex::TickPendingPackages)
+        );
+    }
+}
+
+bool
+FSimpleAssetLibraryIndex::TickPendingPackages(float DeltaTime)
+{
+    PendingTickerHandle.Reset();
+    const TMap<FName, bool> Packages = MoveTemp(PendingPackages);
+    const TMap<FName, FSimpleAssetLibraryEntry> Renamed = MoveTemp(RenamedEntries);
+    PendingPackages.Reset();
+    RenamedEntries.Reset();
+
+    // the shared textures of the renamed entries move to the new names below, they aren't forgotten with the old ones
+    TSet<FName> RenamedFrom;
+    for (const TPair<FName, FSimpleAssetLibraryEntry>& Pair : Renamed)
+    {
+        RenamedFrom.Add(Pair.Value.PackageName);
+    }
+
+    int32 NumChanged = 0;
+    for (const TPair<FName, bool>& Pair : Packages)
+    {
+        const FName PackageName = Pair.Key;
+        if (Pair.Value) {
+            const int32 Row = Store.Find(PackageName);
+            if (Row != INDEX_NONE) {
+                Store.RemoveAt(Row);
+                NumChanged++;
+            }
+            if (!RenamedFrom.Contains(PackageName)) {
+                SimpleAssetLibraryThumbnails::ForgetSharedLibraryThumbnailTexture(PackageName);
+            }
+            continue;
+        }
+        NumChanged += UpdatePackage(PackageName) ? 1 : 0;
+
+        // a renamed or moved entry keeps its thumbnail, the image is the same
+        if (const FSimpleAssetLibraryEntry* OldEntry = Renamed.Find(PackageName)) {
+            const int32 Row = Store.Find(PackageName);
+            if (Row != INDEX_NONE && !Store.GetThumbnails()[Row].IsSet() && OldEntry->Thumbnail.IsSet()) {
+                Store.SetThumbnail(Row, OldEntry->Thumbnail, EnumHasAnyFlags(OldEntry->Flags, ESimpleAssetLibraryEntryFlags::SharedThumbnail));
+            }
+            SimpleAssetLibraryThumbnails::RenameSharedLibraryThumbnailTexture(OldEntry->PackageName, PackageName);
+        }
+    }
+
+    if (NumChanged > 0) {
+        UE_LOG(AssetLibrary, Verbose, TEXT("Updated %d Asset Library entries renamed, moved or deleted in the editor"), NumChanged);
+        FinishUpdate();
+    }
+    return false;
+}
+
+TArrayView<int32>
+FSimpleAssetLibraryIndex::Query(FName AssetType, FName Category, FSimpleAssetLibraryQueryArena& Arena) const
+{
+    FSimpleAssetLibraryFilter Filter;
+    Filter.AssetTypes.Add(AssetType);
+    Filter.Categories.Add(Category);
+    return Query(Filter, Arena);
+}
+
+TArrayView<int32>
+FSimpleAssetLibraryIndex::Query(const FSimpleAssetLibraryFilter& Filter, FSimpleAssetLibraryQueryArena& Arena) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_SimpleAssetLibrary_Query);
+
+    const TArrayView<uint64> Bits = EvaluateFilter(Filter, ESimpleAssetLibraryFilterCriterion::Num, Arena);
+    TArrayView<int32> Rows = Arena.Allocate<int32>(FSimpleAssetLibraryFilterBits::CountBits(Bits));
+
+    // the set bits in order are the matching rows in sort order
+    int32 NumRows = 0;
+    for (int32 WordIndex = 0; WordIndex < Bits.Num(); WordIndex++)
+    {
+        uint64 Word = Bits[WordIndex];
+        while (Word != 0)
+        {
+            Rows[NumRows++] = WordIndex * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Word));
+            Word &= Word - 1;
+        }
+    }
+    return Rows;
+}
+
+int32
+FSimpleAssetLibraryIndex::Count(const FSimpleAssetLibraryFilter& Filter, FSimpleAssetLibraryQueryArena& Arena) const
+{
+    return FSimpleAssetLibraryFilterBits::CountBits(EvaluateFilter(Filter, ESimpleAssetLibraryFilterCriterion::Num, Arena));
+}
+
+TArrayView<int32>
+FSimpleAssetLibraryIndex::CountByValue(const FSimpleAssetLibraryFilter& Filter, ESimpleAssetLibraryFilterCriterion Criterion, FSimpleAssetLibraryQueryArena& Arena) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_SimpleAssetLibrary_CountByValue);
+
+    const FSimpleAssetLibraryFilterBits& Bits = GetFilterBits();
+    const TArrayView<uint64> Matches = EvaluateFilter(Filter, Criterion, Arena);
+    TArrayView<int32> Counts = Arena.Allocate<int32>(Bits.NumValues(Criterion));
+    for (int32 ValueId = 0; ValueId < Counts.Num(); ValueId++)
+    {
+        const uint64* ValueBits = Bits.GetBits(Criterion, ValueId);
+        int32 Count = 0;
+        for (int32 WordIndex = 0; WordIndex < Matches.Num(); WordIndex++)
+        {
+            Count += static_cast<int32>(FMath::CountBits(Matches[WordIndex] & ValueBits[WordIndex]));
+        }
+        Counts[ValueId] = Count;
+    }
+    return Counts;
+}
+
+FName
+FSimpleAssetLibraryIndex::GetCriterionValue(ESimpleAssetLibraryFilterCriterion Criterion, int32 ValueId) const
+{
+    switch (Criterion)
+    {
+    case ESimpleAssetLibraryFilterCriterion::AssetType:
+        return Store.GetNames().AssetTypes.GetName(ValueId);
+    case ESimpleAssetLibraryFilterCriterion::Category:
+        return Store.GetNames().Categories.GetName(ValueId);
+    case ESimpleAssetLibraryFilterCriterion::AddedBy:
+        return Store.GetNames().Authors.GetName(ValueId);
+    case ESimpleAssetLibraryFilterCriterion::UnrealClass: {
+        const TArray<FTopLevelAssetPath>& ClassPaths = GetFilterBits().GetClassPaths();
+        return ClassPaths.IsValidIndex(ValueId) ? FName(ClassPaths[ValueId].ToString()) : NAME_None;
+    }
+    default:
+        return NAME_None;
+    }
+}
+
+TArrayView<int32>
+FSimpleAssetLibraryIndex::FilterByName(const FString& Text, TArrayView<int32> Rows, FSimpleAssetLibraryQueryArena& Arena) const
+{
+    if (Text.IsEmpty()) {
+        return Rows;
+    }
+
+    const TArrayView<bool> RowMatches = FindNameMatches(Text, Arena);
+    int32 NumMatches = 0;
+    for (int32 Row : Rows)
+    {
+        if (RowMatches[Row]) {
+            Rows[NumMatches++] = Row;
+        }
+    }
+    return Rows.Left(NumMatches);
+}
+
+TArrayView<int32>
+FSimpleAssetLibraryIndex::GetCategoryIds(FName AssetType, FSimpleAssetLibraryQueryArena& Arena) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_SimpleAssetLibrary_CategoryFacets);
+
+    FSimpleAssetLibraryFilter Filter;
+    Filter.AssetTypes.Add(AssetType);
+    const TArrayView<int32> Counts = CountByValue(Filter, ESimpleAssetLibraryFilterCriterion::Category, Arena);
+
+    TArrayView<int32> UsedCategoryIds = Arena.Allocate<int32>(Counts.Num());
+    int32 NumUsed = 0;
+    for (int32 CategoryId = 0; CategoryId < Counts.Num(); CategoryId++)
+    {
+        if (Counts[CategoryId] > 0) {
+            UsedCategoryIds[NumUsed++] = CategoryId;
+        }
+    }
+    return UsedCategoryIds.Left(NumUsed);
+}
+
+const FSimpleAssetLibraryFilterBits&
+FSimpleAssetLibraryIndex::GetFilterBits() const
+{
+    if (FilterBits->GetRevision() != Store.GetRevision()) {
+        SCOPE_CYCLE_COUNTER(STAT_SimpleAssetLibrary_BuildFilterBits);
+        FilterBits->Build(Store);
+    }
+    return *FilterBits;
+}
+
+TArrayView<uint64>
+FSimpleAssetLibraryIndex::EvaluateFilter(const FSimpleAssetLibraryFilter& Filter, ESimpleAssetLibraryFilterCriterion IgnoredCriterion, FSimpleAssetLibraryQueryArena& Arena) const
+{
+    const FSimpleAssetLibraryFilterBits& Bits = GetFilterBits();
+    const int32 NumWords = Bits.NumWords();
+
+    TArrayView<uint64> Result = Arena.Allocate<uint64>(NumWords);
+    if (NumWords == 0) {
+        return Result;
+    }
+    FMemory::Memset(Result.GetData(), 0xFF, NumWords * sizeof(uint64));
+    Result[NumWords - 1] &= Bits.GetLastWordMask();
+
+    // OR the bitsets of the values of each criterion, then AND the criteria
+    TArrayView<uint64> CriterionBits = Arena.Allocate<uint64>(NumWords);
+    TArray<int32, TInlineAllocator<16>> ValueIds;
+    for (int32 CriterionIndex = 0; CriterionIndex < static_cast<int32>(ESimpleAssetLibraryFilterCriterion::Num); CriterionIndex++)
+    {
+        const ESimpleAssetLibraryFilterCriterion Criterion = static_cast<ESimpleAssetLibraryFilterCriterion>(CriterionIndex);
+        if (Criterion == IgnoredCriterion || !ResolveCriterion(Filter, Criterion, ValueIds)) {
+            continue;
+        }
+
+        FMemory::Memzero(CriterionBits.GetData(), NumWords * sizeof(uint64));
+        for (int32 ValueId : ValueIds)
+        {
+            const uint64* ValueBits = Bits.GetBits(Criterion, ValueId);
+            for (int32 WordIndex = 0; WordIndex < NumWords; WordIndex++)
+            {
+                CriterionBits[WordIndex] |= ValueBits[WordIndex];
+            }
+        }
+        for (int32 WordIndex = 0; WordIndex < NumWords; WordIndex++)
+        {
+            Result[WordIndex] &= CriterionBits[WordIndex];
+        }
+    }
+
+    if (!Filter.SearchText.IsEmpty()) {
+        const TArrayView<bool> RowMatches = FindNameMatches(Filter.SearchText, Arena);
+        for (int32 WordIndex = 0; WordIndex < NumWords; WordIndex++)
+        {
+            uint64 Word = Result[WordIndex];
+            for (uint64 Remaining = Word; Remaining != 0; Remaining &= Remaining - 1)
+            {
+                const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Remaining));
+                if (!RowMatches[WordIndex * 64 + Bit]) {
+                    Word &= ~(uint64(1) << Bit);
+                }
+            }
+            Result[WordIndex] = Word;
+        }
+    }
+    return Result;
+}
+
+bool
+FSimpleAssetLibraryIndex::ResolveCriterion(const FSimpleAssetLibraryFilter& Filter, ESimpleAssetLibraryFilterCriterion Criterion, TArray<int32, TInlineAllocator<16>>& OutValueIds) const
+{
+    OutValueIds.Reset();
+
+    const FSimpleAssetLibraryNameTable* Table = nullptr;
+    const TArray<FName>* Values = nullptr;
+    switch (Criterion)
+    {
+    case ESimpleAssetLibraryFilterCriterion::AssetType:
+        Table = &Store.GetNames().AssetTypes;
+        Values = &Filter.AssetTypes;
+        break;
+    case ESimpleAssetLibraryFilterCriterion::Category:
+        Table = &Store.GetNames().Categories;
+        Values = &Filter.Categories;
+        break;
+    case ESimpleAssetLibraryFilterCriterion::AddedBy:
+        Table = &Store.GetNames().Authors;
+        Values = &Filter.AddedBy;
+        break;
+    case ESimpleAssetLibraryFilterCriterion::UnrealClass:
+        for (const FString& ClassName : Filter.UnrealClasses)
+        {
+            if (ClassName.IsEmpty() || ClassName.Equals(SimpleAssetLibraryTags::All.ToString(), ESearchCase::IgnoreCase)) {
+                return false;
+            }
+            GetFilterBits().FindClassIds(ClassName, Filter.bIncludeDerivedClasses, OutValueIds);
+        }
+        return Filter.UnrealClasses.Num() > 0;
+    default:
+        return false;
+    }
+
+    for (const FName Value : *Values)
+    {
+        if (Value.IsNone() || Value == SimpleAssetLibraryTags::All) {
+            return false;
+        }
+        const int32 ValueId = Table->Find(Value);
+        if (ValueId != INDEX_NONE) {
+            OutValueIds.AddUnique(ValueId);
+        }
+    }
+    return Values->Num() > 0;
+}
+
+TArrayView<bool>
+FSimpleAssetLibraryIndex::FindNameMatches(const FString& Text, FSimpleAssetLibraryQueryArena& Arena) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_SimpleAssetLibrary_FilterByName);
+
+    // Same match as commands.filter_asset_list_for_gui: the display name or the asset name
+    if (NameSearch->GetRevision() != Store.GetRevision()) {
+        NameSearch->Build(Store);
+    }
+    TArrayView<bool> RowMatches = Arena.Allocate<bool>(Store.Num());
+    FMemory::Memzero(RowMatches.GetData(), Store.Num() * sizeof(bool));
+    NameSearch->FindMatches(Text, RowMatches);
+    return RowMatches;
+}
+
+bool
+FSimpleAssetLibraryIndex::SaveManifest()
+{
+    if (!bDirty) {
+        return true;
+    }
+
+    // the compacted offsets are saved with the manifest below
+    CompactThumbnailCacheIfNeeded();
+
+    const FString Filename = GetManifestFilename();
+    FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*FPaths::GetPath(Filename));
+    if (!SimpleAssetLibraryManifest::Save(Filename, Store, SeedPackId)) {
+        return false;
+    }
+    bDirty = false;
+    return true;
+}
+
+void
+FSimpleAssetLibraryIndex::CompactThumbnailCacheIfNeeded()
+{
+    // the images of the local entries, the shared ones are in the pack's blob
+    TArray<int32> Rows;
+    TArray<TPair<int64, int32>> LiveImages;
+    TSet<int64> LiveOffsets;
+    int64 LiveBytes = 0;
+    for (int32 Row = 0; Row < Store.Num(); Row++)
+    {
+        const FSimpleAssetLibraryThumbnailRef& Thumbnail = Store.GetThumbnails()[Row];
+        if (!Thumbnail.IsSet() || EnumHasAnyFlags(Store.GetFlags()[Row], ESimpleAssetLibraryEntryFlags::SharedThumbnail)) {
+            continue;
+        }
+        Rows.Add(Row);
+        LiveImages.Emplace(Thumbnail.Offset, Thumbnail.Size);
+        bool bIsShared = false;
+        LiveOffsets.Add(Thumbnail.Offset, &bIsShared);
+        LiveBytes += bIsShared ? 0 : Thumbnail.Size;
+    }
+
+    const int64 CacheSize = ThumbnailCache->GetSize();
+    const int64 DeadBytes = CacheSize - LiveBytes;
+    if (DeadBytes < MinCompactThumbnailBytes || DeadBytes < CacheSize / 4) {
+        return;
+    }
+
+    TArray<int64> NewOffsets;
+    if (!ThumbnailCache->Compact(LiveImages, NewOffsets)) {
+        return;
+    }
+    for (int32 Index = 0; Index < Rows.Num(); Index++)
+    {
+        FSimpleAssetLibraryThumbnailRef Thumbnail = Store.GetThumbnails()[Rows[Index]];
+        Thumbnail.Offset = NewOffsets[Index];
+        Store.SetThumbnail(Rows[Index], Thumbnail, false);
+    }
+    UE_LOG(AssetLibrary, Log, TEXT("Compacted the Asset Library thumbnail cache from %lld to %lld bytes"), CacheSize, ThumbnailCache->GetSize());
+}
+
+bool
+FSimpleAssetLibraryIndex::LoadCachedThumbnail(FName PackageName, TArray<uint8>& OutCompressedImage, int32& OutWidth, int32& OutHeight) const
+{
+    const int32 Row = Store.Find(PackageName);
+    if (Row == INDEX_NONE || !Store.GetThumbnails()[Row].IsSet()) {
+        return false;
+    }
+
+    const FSimpleAssetLibraryThumbnailRef& Thumbnail = Store.GetThumbnails()[Row];
+    if (EnumHasAnyFlags(Store.GetFlags()[Row], ESimpleAssetLibraryEntryFlags::SharedThumbnail)) {
+        if (!SharedPack || !SharedPack->ReadThumbnail(Thumbnail.Offset, Thumbnail.Size, OutCompressedImage)) {
+            return false;
+        }
+    }
+    else if (!ThumbnailCache->Read(Thumbnail.Offset, Thumbnail.Size, OutCompressedImage)) {
+        return false;
+    }
+    OutWidth = Thumbnail.Width;
+    OutHeight = Thumbnail.Height;
+    return true;
+}
+
+void
+FSimpleAssetLibraryIndex::CacheThumbnail(FName PackageName, TConstArrayView<uint8> CompressedImage, int32 Width, int32 Height)
+{
+    const int32 Row = Store.Find(PackageName);
+    if (Row == INDEX_NONE) {
+        return;
+    }
+
+    FSimpleAssetLibraryThumbnailRef Thumbnail;
+    Thumbnail.Offset = ThumbnailCache->Append(CompressedImage);
+    if (Thumbnail.Offset == INDEX_NONE) {
+        return;
+    }
+    Thumbnail.Size = CompressedImage.Num();
+    Thumbnail.Width = Width;
+    Thumbnail.Height = Height;
+    Store.SetThumbnail(Row, Thumbnail, false);
+    bDirty = true;
+}
+
+bool
+FSimpleAssetLibraryIndex::ExportSharedPack(const FString& Directory)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    IAssetRegistry& AssetRegistry = GetAssetRegistry();
+
+    // Gather the thumbnail of every entry into a single blob, generating the missing ones
+    FSimpleAssetLibraryEntryStore PackStore = Store;
+    TArray<uint8> ThumbnailBlob;
+    TMap<uint64, FSimpleAssetLibraryThumbnailRef> ThumbnailsByHash;
+    int32 NumMissingThumbnails = 0;
+    int32 NumSharedThumbnails = 0;
+    for (int32 Row = 0; Row < PackStore.Num(); Row++)
+    {
+        TArray<uint8> Image;
+        int32 Width = 0;
+        int32 Height = 0;
+        if (!LoadCachedThumbnail(PackStore.GetPackageNames()[Row], Image, Width, Height)) {
+            TArray64<uint8> PackageImage;
+            const FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(PackStore.GetObjectPaths()[Row]);
+            if (SimpleAssetLibraryThumbnails::LoadCompressedPackageThumbnail(AssetData, PackageImage, Width, Height)) {
+                Image = TArray<uint8>(PackageImage.GetData(), static_cast<int32>(PackageImage.Num()));
+            }
+        }
+
+        // identical thumbnails are stored once, their entries point at the same image
+        const uint64 ImageHash = FXxHash64::HashBuffer(Image.GetData(), Image.Num()).Hash;
+        const FSimpleAssetLibraryThumbnailRef* SharedThumbnail = ThumbnailsByHash.Find(ImageHash);
+        if (Image.Num() > 0 && SharedThumbnail && SharedThumbnail->Size == Image.Num()) {
+            PackStore.SetThumbnail(Row, *SharedThumbnail, true);
+            NumSharedThumbnails++;
+        }
+        else {
+            FSimpleAssetLibraryThumbnailRef Thumbnail;
+            Thumbnail.Offset = Image.Num() > 0 ? ThumbnailBlob.Num() : INDEX_NONE;
+            Thumbnail.Size = Image.Num();
+            Thumbnail.Width = Width;
+            Thumbnail.Height = Height;
+            PackStore.SetThumbnail(Row, Thumbnail, Image.Num() > 0);
+            NumMissingThumbnails += Image.Num() > 0 ? 0 : 1;
+            ThumbnailBlob.Append(Image);
+            if (Image.Num() > 0) {
+                ThumbnailsByHash.Add(ImageHash, Thumbnail);
+            }
+        }
+
+        // a sync gives the files of the pack another time in every workspace, the content hash tells them they're the same
+        const FName PackageName = PackStore.GetPackageNames()[Row];
+        if (PackStore.GetFingerprints()[Row].Hash == 0) {
+            PackStore.SetFingerprint(Row, FSimpleAssetLibraryPackageFingerprint::FromPackage(PackageName, true));
+        }
+    }
+
+    // The mapped pack has to be released before its files can be replaced
+    const bool bIsMountedPack = SharedPack && FPaths::IsSamePath(SharedPack->GetDirectory(), Directory);
+    if (bIsMountedPack) {
+        SharedPack.Reset();
+    }
+
+    FGuid WrittenPackId;
+    const bool bWritten = FSimpleAssetLibraryPack::Write(Directory, PackStore, ThumbnailBlob, WrittenPackId);
+    UE_LOG(AssetLibrary, Log, TEXT("%s the shared library pack %s: %d entries, %d without thumbnail, %d sharing the thumbnail of another entry, %.1f MB of thumbnails (%.2f ms)"),
+        bWritten ? TEXT("Exported") : TEXT("Failed to export"), *Directory, PackStore.Num(), NumMissingThumbnails, NumSharedThumbnails,
+        ThumbnailBlob.Num() / (1024.0 * 1024.0), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+    // Our entries are the pack's entries now, read the thumbnails from the new pack
+    // a failed export leaves the previous pack in place, it's mounted again and the entries keep their thumbnails
+    if (bIsMountedPack && MountSharedPack() && bWritten && SharedPack->GetPackId() == WrittenPackId) {
+        Store = MoveTemp(PackStore);
+        SeedPackId = SharedPack->GetPackId();
+        bDirty = true;
+        SaveManifest();
+    }
+    return bWritten;
+}
+
+FString
+FSimpleAssetLibraryIndex::GetManifestFilename()
+{
+    return FPaths::ProjectSavedDir() / TEXT("SimpleAssetLibrary/LibraryManifest.bin");
+}
+
+FString
+FSimpleAssetLibraryIndex::GetThumbnailCacheFilename()
+{
+    return FPaths::ProjectSavedDir() / TEXT("SimpleAssetLibrary/LibraryThumbnails.bin");
+}
+
+bool
+FSimpleAssetLibraryIndex::LoadManifest()
+{
+    // the manifest is written in sort order already
+    if (!SimpleAssetLibraryManifest::Load(GetManifestFilename(), Store, SeedPackId)) {
+        return false;
+    }
+    bDirty = false;
+    return true;
+}
+
+bool
+FSimpleAssetLibraryIndex::MountSharedPack()
+{
+    SharedPack.Reset();
+
+    const FString& Directory = FSimpleAssetLibraryModule::Get().GetSharedPackDirectory();
+    if (Directory.IsEmpty() || !FPaths::FileExists(FSimpleAssetLibraryPack::GetManifestFilename(Directory))) {
+        return false;
+    }
+
+    TUniquePtr<FSimpleAssetLibraryPack> Pack = MakeUnique<FSimpleAssetLibraryPack>();
+    if (!Pack->Mount(Directory)) {
+        return false;
+    }
+    SharedPack = MoveTemp(Pack);
+    return true;
+}
+
+void
+FSimpleAssetLibraryIndex::StartValidation()
+{
+    // Validate the restored entries over the next frames rather than blocking the first open
+    InvalidEntries.Init(false, Store.Num());
+    ValidationCursor = 0;
+    NumChangedPackages = 0;
+    ValidationTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateRaw(this, &FSimpleAssetLibraryIndex::TickValidation)
+    );
+}
+
+bool
+FSimpleAssetLibraryIndex::TickValidation(float DeltaTime)
+{
+    IAssetRegistry& AssetRegistry = GetAssetRegistry();
+
+    // wait for discovery to finish, an incomplete registry would invalidate valid entries
+    if (AssetRegistry.IsLoadingAssets()) {
+        return true;
+    }
+
+    const int32 BatchEnd = FMath::Min(ValidationCursor + ValidationBatchSize, Store.Num());
+    for (; ValidationCursor < BatchEnd; ValidationCursor++)
+    {
+        // the library tags are read from the package file, an unchanged file needs no registry lookup
+        FSimpleAssetLibraryPackageFingerprint Fingerprint;
+        if (Store.GetFingerprints()[ValidationCursor].MatchesPackage(Store.GetPackageNames()[ValidationCursor], Fingerprint)) {
+            continue;
+        }
+        NumChangedPackages++;
+
+        FSimpleAssetLibraryEntry CurrentEntry;
+        const FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(Store.GetObjectPaths()[ValidationCursor]);
+        if (!FSimpleAssetLibraryEntry::FromAssetData(AssetData, Store.GetNames(), CurrentEntry)) {
+            InvalidEntries[ValidationCursor] = true;
+            continue;
+        }
+
+        // the package changed, its cached thumbnail may be outdated even if the library data is the same
+        // the sort key may change, rows are only reordered once the validation is finished
+        CurrentEntry.Fingerprint = Fingerprint;
+        Store.Set(ValidationCursor, MoveTemp(CurrentEntry));
+        bDirty = true;
+    }
+
+    if (ValidationCursor < Store.Num()) {
+        return true;
+    }
+
+    ValidationTickerHandle.Reset();
+    FinishValidation();
+    return false;
+}
+
+void
+FSimpleAssetLibraryIndex::FinishValidation()
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    // Drop the entries that are no longer registered
+    const int32 NumValidated = Store.Num();
+    Store.Remove(InvalidEntries);
+    const int32 NumRemoved = NumValidated - Store.Num();
+    InvalidEntries.Empty();
+
+    // Pick up assets registered since the manifest was written (e.g. by another user)
+    TArray<FAssetData> Assets;
+    FindRegisteredAssets(Assets);
+
+    int32 NumAdded = 0;
+    for (const FAssetData& AssetData : Assets)
+    {
+        FSimpleAssetLibraryEntry NewEntry;
+        if (Store.Find(AssetData.PackageName) == INDEX_NONE && FSimpleAssetLibraryEntry::FromAssetData(AssetData, Store.GetNames(), NewEntry)) {
+            NewEntry.Fingerprint = FSimpleAssetLibraryPackageFingerprint::FromPackage(NewEntry.PackageName, false);
+            Store.Add(MoveTemp(NewEntry));
+            NumAdded++;
+        }
+    }
+
+    Store.Sort();
+    bDirty |= NumAdded > 0 || NumRemoved > 0;
+
+    UE_LOG(AssetLibrary, Log, TEXT("Validated the Asset Library manifest: %d entries, %d packages changed, %d added, %d removed (%.2f ms)"),
+        Store.Num(), NumChangedPackages, NumAdded, NumRemoved, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+    SaveManifest();
+    if (NumAdded > 0 || NumRemoved > 0) {
+        EntriesChanged.Broadcast();
+    }
+}
+
+void
+FSimpleAssetLibraryIndex::FindRegisteredAssets(TArray<FAssetData>& OutAssets) const
+{
+    FARFilter Filter;
+    Filter.TagsAndValues.Add(SimpleAssetLibraryTags::ManagedAsset, FString(TEXT("True")));
+    GetAssetRegistry().GetAssets(Filter, OutAssets);
+}
@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SimpleAssetLibraryManifest.h"
+#include "SimpleAssetLibraryEntryStore.h"
+#include "SimpleAssetLibraryBPLibrary.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+
+namespace SimpleAssetLibraryManifest
+{
+    static bool ReadEntries(FMemoryView Data, const FString& Filename, FSimpleAssetLibraryEntryStore& OutStore, FGuid& OutPackId)
+    {
+        FMemoryReaderView Reader(Data);
+
+        uint32 FileMagic = 0;
+        uint32 FileVersion = 0;
+        Reader << FileMagic << FileVersion;
+
+        if (Reader.IsError() || FileMagic != Magic) {
+            UE_LOG(AssetLibrary, Warning, TEXT("%s is not an Asset Library manifest, it will be rebuilt"), *Filename);
+            return false;
+        }
+        if (FileVersion != Version) {
+            UE_LOG(AssetLibrary, Log, TEXT("%s is manifest version %u (current: %u), it will be rebuilt"), *Filename, FileVersion, Version);
+            return false;
+        }
+
+        Reader << OutPackId << OutStore;
+        if (Reader.IsError()) {
+            UE_LOG(AssetLibrary, Warning, TEXT("%s is corrupted, it will be rebuilt"), *Filename);
+            OutStore.Reset();
+            return false;
+        }
+        return true;
+    }
+
+    bool Save(const FString& Filename, FSimpleAssetLibraryEntryStore& Store, const FGuid& PackId)
+    {
+        TArray<uint8> Data;
+        FMemoryWriter Writer(Data);
+
+        uint32 FileMagic = Magic;
+        uint32 FileVersion = Version;
+        FGuid FilePackId = PackId;
+        Writer << FileMagic << FileVersion << FilePackId << Store;
+
+        const FString TempFilename = Filename + TEXT(".tmp");
+        if (!FFileHelper::SaveArrayToFile(Data, *TempFilename)) {
+            UE_LOG(AssetLibrary, Warning, TEXT("Failed to write the Asset Library manifest: %s"), *TempFilename);
+            return false;
+        }
+        if (!IFileManager::Get().Move(*Filename, *TempFilename, true, true)) {
+            UE_LOG(AssetLibrary, Warning, TEXT("Failed to replace the Asset Library manifest: %s"), *Filename);
+            IFileManager::Get().Delete(*TempFilename);
+            return false;
+        }
+        return true;
+    }
+
+    bool Load(const FString& Filename, FSimpleAssetLibraryEntryStore& OutStore, FGuid& OutPackId)
+    {
+        OutStore.Reset();
+        OutPackId.Invalidate();
+
+        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+        if (!PlatformFile.FileExists(*Filename)) {
+            return false;
+        }
+
+        // Map the manifest rather than reading it into a buffer first
+        TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*Filename));
+        TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile ? MappedFile->MapRegion() : nullptr);
+        if (MappedRegion) {
+            return ReadEntries(FMemoryView(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize()), Filename, OutStore, OutPackId);
+        }
+
+        // Some platform file layers can't map files, fall back to a regular read
+        TArray<uint8> Data;
+        if (!FFileHelper::LoadFileToArray(Data, *Filename)) {
+            return false;
+        }
+        return ReadEntries(FMemoryView(Data.GetData(), Data.Num()), Filename, OutStore, OutPackId);
+    }
+}
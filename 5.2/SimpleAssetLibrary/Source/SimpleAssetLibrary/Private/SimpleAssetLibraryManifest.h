@@ -0,0 +1,36 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FSimpleAssetLibraryEntryStore;
+
+
+/*
+*	Binary manifest of the Asset Library index.
+*
+*	Layout: a fixed header (magic, format version, pack id), then the entry store: the name tables of
+*	the interned metadata values, the entry count and one column after the other.
+*	The manifest is memory-mapped when read so opening the library doesn't pay for a buffered copy.
+*	Bump Version whenever the entry layout changes, older manifests are then ignored and rebuilt.
+*
+*	The same format is used for the shared library pack, the pack id identifies the exported pack.
+*	A local manifest records the id of the pack it was seeded from (invalid if none) so it can be
+*	discarded when a new pack is synced.
+*/
+namespace SimpleAssetLibraryManifest
+{
+	static constexpr uint32 Magic = 0x53414C4D; // 'SALM'
+	static constexpr uint32 Version = 5;
+
+	/**  Write the entries to the given manifest file, through a temp file so readers never see a partial manifest
+	 * @return  whether the manifest was written
+	 */
+	bool Save(const FString& Filename, FSimpleAssetLibraryEntryStore& Store, const FGuid& PackId);
+
+	/**  Read the entries from the given manifest file
+	 * @return  false if the file is missing, from another format version or corrupted
+	 */
+	bool Load(const FString& Filename, FSimpleAssetLibraryEntryStore& OutStore, FGuid& OutPackId);
+}
@@ -0,0 +1,58 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SimpleAssetLibraryEntryStore.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+
+/*
+*	Read-only library pack shared by the whole team through source control.
+*
+*	A pack is a folder holding a library manifest and the compressed thumbnails of its entries:
+*		<pack>/LibraryManifest.bin
+*		<pack>/LibraryThumbnails_<pack id>.bin
+*	The thumbnail blob stays memory-mapped while the pack is mounted, entries point into it by offset.
+*	The blob is named after the pack id of its manifest, a manifest is never mounted with another export's blob.
+*/
+class FSimpleAssetLibraryPack
+{
+public:
+	FSimpleAssetLibraryPack();
+	~FSimpleAssetLibraryPack();
+
+	/**  Mount the pack in the given folder
+	 * @return  false if the folder doesn't contain a valid pack
+	 */
+	bool Mount(const FString& InDirectory);
+
+	/**  Copy a thumbnail out of the mapped thumbnail blob
+	 * @return  false if the location is outside of the blob
+	 */
+	bool ReadThumbnail(int64 Offset, int32 Size, TArray<uint8>& OutData) const;
+
+	const FGuid& GetPackId() const { return PackId; }
+	const FString& GetDirectory() const { return Directory; }
+	const FSimpleAssetLibraryEntryStore& GetStore() const { return Store; }
+
+	/**  Write a pack to the given folder, the thumbnails must already be in pack order
+	 * @param  InStore  the pack entries, their thumbnail offsets must point into ThumbnailBlob
+	 * @param  ThumbnailBlob  the compressed thumbnails of the entries
+	 * @param  OutPackId  the id of the written pack
+	 * @return  false if the pack couldn't be written, the previous pack is then left as it was
+	 */
+	static bool Write(const FString& InDirectory, FSimpleAssetLibraryEntryStore& InStore, TConstArrayView<uint8> ThumbnailBlob, FGuid& OutPackId);
+
+	static FString GetManifestFilename(const FString& InDirectory);
+	static FString GetThumbnailsFilename(const FString& InDirectory, const FGuid& InPackId);
+
+private:
+	FString Directory;
+	FGuid PackId;
+	FSimpleAssetLibraryEntryStore Store;
+	TUniquePtr<IMappedFileHandle> MappedThumbnails;
+	TUniquePtr<IMappedFileRegion> MappedThumbnailsRegion;
+};
@@ -0,0 +1,220 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SimpleAssetLibraryPrefsStore.h"
+#include "SimpleAssetLibrary.h"
+#include "SimpleAssetLibraryBPLibrary.h"
+
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+
+namespace
+{
+    // Seconds between the last change and the write, the changes made meanwhile are written together
+    constexpr double WriteDelay = 1.0;
+
+    bool WriteFileAtomic(const FString& Filename, const FString& Text)
+    {
+        const FString TempFilename = Filename + TEXT(".tmp");
+        if (!FFileHelper::SaveStringToFile(Text, *TempFilename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)) {
+            UE_LOG(AssetLibrary, Warning, TEXT("Failed to write the Asset Library settings: %s"), *TempFilename);
+            return false;
+        }
+        if (!IFileManager::Get().Move(*Filename, *TempFilename, true, true)) {
+            UE_LOG(AssetLibrary, Warning, TEXT("Failed to replace the Asset Library settings: %s"), *Filename);
+            IFileManager::Get().Delete(*TempFilename);
+            return false;
+        }
+        return true;
+    }
+}
+
+
+FSimpleAssetLibraryPrefsStore::FSimpleAssetLibraryPrefsStore(const FString& InFilename)
+: Filename(InFilename)
+{}
+
+FSimpleAssetLibraryPrefsStore::~FSimpleAssetLibraryPrefsStore()
+{
+    Flush();
+}
+
+FSimpleAssetLibraryPrefsStore&
+FSimpleAssetLibraryPrefsStore::Get()
+{
+    return FSimpleAssetLibraryModule::Get().GetPrefsStore();
+}
+
+bool
+FSimpleAssetLibraryPrefsStore::Load(FName PanelName, FSimpleAssetLibraryPrefs& OutPrefs)
+{
+    ReadIfNeeded();
+    OutPrefs = FSimpleAssetLibraryPrefs();
+    if (Json->Values.IsEmpty()) {
+        return false;
+    }
+
+    double MaxDistance = OutPrefs.SpawnSettings.MaxDistance;
+    double EntrySize = OutPrefs.EntrySize;
+    Json->TryGetBoolField(TEXT("align_to_surface"), OutPrefs.SpawnSettings.bAlignToSurface);
+    Json->TryGetBoolField(TEXT("ignore_placed_assets"), OutPrefs.SpawnSettings.bIgnorePlacedAssets);
+    Json->TryGetBoolField(TEXT("select_after_spawning"), OutPrefs.SpawnSettings.bSelectAfterSpawning);
+    Json->TryGetNumberField(TEXT("max_distance"), MaxDistance);
+    Json->TryGetBoolField(TEXT("show_add_entry_button"), OutPrefs.bShowAddEntryButton);
+    Json->TryGetBoolField(TEXT("show_delete_button"), OutPrefs.bShowDeleteButton);
+    Json->TryGetNumberField(TEXT("entry_size"), EntrySize);
+    OutPrefs.SpawnSettings.MaxDistance = static_cast<float>(MaxDistance);
+    OutPrefs.EntrySize = static_cast<float>(EntrySize);
+
+    // A named window that never saved its filter starts unfiltered
+    const TSharedPtr<FJsonObject>* PanelJson = &Json;
+    const TSharedPtr<FJsonObject>* Panels = nullptr;
+    if (!PanelName.IsNone()) {
+        if (!Json->TryGetObjectField(TEXT("panels"), Panels) || !(*Panels)->TryGetObjectField(PanelName.ToString(), PanelJson)) {
+            return true;
+        }
+    }
+    (*PanelJson)->TryGetStringField(TEXT("ui_state_type"), OutPrefs.AssetType);
+    (*PanelJson)->TryGetStringField(TEXT("ui_state_category"), OutPrefs.Category);
+    (*PanelJson)->TryGetStringField(TEXT("ui_state_filter"), OutPrefs.SearchText);
+    return true;
+}
+
+bool
+FSimpleAssetLibraryPrefsStore::Save(const FSimpleAssetLibraryPrefs& Prefs, FName PanelName)
+{
+    ReadIfNeeded();
+    Json->SetBoolField(TEXT("align_to_surface"), Prefs.SpawnSettings.bAlignToSurface);
+    Json->SetBoolField(TEXT("ignore_placed_assets"), Prefs.SpawnSettings.bIgnorePlacedAssets);
+    Json->SetBoolField(TEXT("select_after_spawning"), Prefs.SpawnSettings.bSelectAfterSpawning);
+    Json->SetNumberField(TEXT("max_distance"), Prefs.SpawnSettings.MaxDistance);
+    Json->SetBoolField(TEXT("show_add_entry_button"), Prefs.bShowAddEntryButton);
+    Json->SetBoolField(TEXT("show_delete_button"), Prefs.bShowDeleteButton);
+    Json->SetNumberField(TEXT("entry_size"), Prefs.EntrySize);
+
+    // The other windows' filters are kept, only this window's is replaced
+    TSharedPtr<FJsonObject> PanelJson = Json;
+    if (!PanelName.IsNone()) {
+        const TSharedPtr<FJsonObject>* Panels = nullptr;
+        TSharedPtr<FJsonObject> PanelsJson = Json->TryGetObjectField(TEXT("panels"), Panels) ? *Panels : MakeShared<FJsonObject>();
+        PanelJson = MakeShared<FJsonObject>();
+        PanelsJson->SetObjectField(PanelName.ToString(), PanelJson);
+        Json->SetObjectField(TEXT("panels"), PanelsJson);
+    }
+    PanelJson->SetStringField(TEXT("ui_state_type"), Prefs.AssetType);
+    PanelJson->SetStringField(TEXT("ui_state_category"), Prefs.Category);
+    PanelJson->SetStringField(TEXT("ui_state_filter"), Prefs.SearchText);
+    return ScheduleWrite();
+}
+
+TArray<FName>
+FSimpleAssetLibraryPrefsStore::GetNames(const TCHAR* Key)
+{
+    ReadIfNeeded();
+    TArray<FString> Values;
+    Json->TryGetStringArrayField(Key, Values);
+
+    TArray<FName> Names;
+    Names.Reserve(Values.Num());
+    for (const FString& Value : Values)
+    {
+        Names.Add(FName(*Value));
+    }
+    return Names;
+}
+
+void
+FSimpleAssetLibraryPrefsStore::SetNames(const TCHAR* Key, TConstArrayView<FName> Names)
+{
+    ReadIfNeeded();
+    TArray<TSharedPtr<FJsonValue>> Values;
+    Values.Reserve(Names.Num());
+    for (const FName Name : Names)
+    {
+        Values.Add(MakeShared<FJsonValueString>(Name.ToString()));
+    }
+    Json->SetArrayField(Key, Values);
+    ScheduleWrite();
+}
+
+bool
+FSimpleAssetLibraryPrefsStore::ScheduleWrite()
+{
+    FString NewText;
+    if (!FJsonSerializer::Serialize(Json.ToSharedRef(), TJsonWriterFactory<>::Create(&NewText)) || NewText == Text) {
+        return false;
+    }
+    Text = MoveTemp(NewText);
+
+    // every change pushes the write back, the window is often saved on each keystroke
+    WriteTime = FPlatformTime::Seconds() + WriteDelay;
+    if (!WriteTickerHandle.IsValid()) {
+        WriteTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateRaw(this, &FSimpleAssetLibraryPrefsStore::TickWrite)
+        );
+    }
+    return true;
+}
+
+void
+FSimpleAssetLibraryPrefsStore::Flush()
+{
+    if (PendingWrite.IsValid()) {
+        PendingWrite.Wait();
+    }
+    if (WriteTickerHandle.IsValid()) {
+        FTSTicker::GetCoreTicker().RemoveTicker(WriteTickerHandle);
+        WriteTickerHandle.Reset();
+        StartWrite();
+        PendingWrite.Wait();
+    }
+}
+
+void
+FSimpleAssetLibraryPrefsStore::ReadIfNeeded()
+{
+    if (bRead) {
+        return;
+    }
+    bRead = true;
+
+    Json.Reset();
+    if (FFileHelper::LoadFileToString(Text, *Filename)) {
+        if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Json) || !Json.IsValid()) {
+            UE_LOG(AssetLibrary, Warning, TEXT("%s is not a valid json file"), *Filename);
+            Json.Reset();
+        }
+    }
+    if (!Json.IsValid()) {
+        Json = MakeShared<FJsonObject>();
+        Text.Reset();
+    }
+}
+
+bool
+FSimpleAssetLibraryPrefsStore::TickWrite(float DeltaTime)
+{
+    // one write at a time, a write still running holds the next one back
+    if (FPlatformTime::Seconds() < WriteTime || (PendingWrite.IsValid() && !PendingWrite.IsReady())) {
+        return true;
+    }
+    WriteTickerHandle.Reset();
+    StartWrite();
+    return false;
+}
+
+void
+FSimpleAssetLibraryPrefsStore::StartWrite()
+{
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(Filename), true);
+    PendingWrite = Async(EAsyncExecution::ThreadPool, [PrefsFilename = Filename, PrefsText = Text]()
+    {
+        return WriteFileAtomic(PrefsFilename, PrefsText);
+    });
+}
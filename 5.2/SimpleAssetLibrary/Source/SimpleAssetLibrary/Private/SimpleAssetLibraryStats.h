@@ -0,0 +1,21 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+
+/* The Asset Library stats, shown with `stat SimpleAssetLibrary` */
+DECLARE_STATS_GROUP(TEXT("Asset Library"), STATGROUP_SimpleAssetLibrary, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Query"), STAT_SimpleAssetLibrary_Query, STATGROUP_SimpleAssetLibrary, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Filter By Name"), STAT_SimpleAssetLibrary_FilterByName, STATGROUP_SimpleAssetLibrary, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Category Facets"), STAT_SimpleAssetLibrary_CategoryFacets, STATGROUP_SimpleAssetLibrary, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Count By Value"), STAT_SimpleAssetLibrary_CountByValue, STATGROUP_SimpleAssetLibrary, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Filter Bitsets"), STAT_SimpleAssetLibrary_BuildFilterBits, STATGROUP_SimpleAssetLibrary, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Resolve Load Set"), STAT_SimpleAssetLibrary_LoadSet, STATGROUP_SimpleAssetLibrary, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Scan Package Headers"), STAT_SimpleAssetLibrary_ScanPackages, STATGROUP_SimpleAssetLibrary, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Query Arena Allocations"), STAT_SimpleAssetLibrary_ArenaAllocations, STATGROUP_SimpleAssetLibrary, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Query Arena Heap Allocations"), STAT_SimpleAssetLibrary_ArenaHeapAllocations, STATGROUP_SimpleAssetLibrary, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Query Arena Memory"), STAT_SimpleAssetLibrary_ArenaMemory, STATGROUP_SimpleAssetLibrary, );
@@ -0,0 +1,202 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SimpleAssetLibraryTypeCatalog.h"
+#include "SimpleAssetLibrary.h"
+
+#include "Misc/Crc.h"
+
+
+namespace
+{
+    TArray<FName> SortedByName(TArray<FName>&& Names)
+    {
+        Names.Sort(FNameLexicalLess());
+        return MoveTemp(Names);
+    }
+}
+
+
+FSimpleAssetLibraryTypeCatalog::FSimpleAssetLibraryTypeCatalog()
+{
+}
+
+FSimpleAssetLibraryTypeCatalog::~FSimpleAssetLibraryTypeCatalog()
+{
+    // the module releases the catalog before the index
+    if (EntriesChangedHandle.IsValid()) {
+        FSimpleAssetLibraryIndex::Get().OnEntriesChanged().Remove(EntriesChangedHandle);
+    }
+}
+
+FSimpleAssetLibraryTypeCatalog&
+FSimpleAssetLibraryTypeCatalog::Get()
+{
+    return FSimpleAssetLibraryModule::Get().GetTypeCatalog();
+}
+
+void
+FSimpleAssetLibraryTypeCatalog::SetConfigTypes(TConstArrayView<FString> Types)
+{
+    TArray<FName> NewConfigTypes;
+    NewConfigTypes.Reserve(Types.Num());
+    for (const FString& Type : Types)
+    {
+        NewConfigTypes.AddUnique(FName(*Type));
+    }
+    if (NewConfigTypes == ConfigTypes) {
+        return;
+    }
+    ConfigTypes = MoveTemp(NewConfigTypes);
+    Colors.Reset();
+    ReportedTypes.Reset();
+    Revision++;
+
+    if (bBuilt) {
+        for (const TPair<FName, int32>& Pair : EntryCounts)
+        {
+            ReportUndeclaredType(Pair.Key);
+        }
+    }
+}
+
+TArray<FName>
+FSimpleAssetLibraryTypeCatalog::GetUsedTypes()
+{
+    BuildIfNeeded();
+    TArray<FName> Types;
+    EntryCounts.GenerateKeyArray(Types);
+    return SortedByName(MoveTemp(Types));
+}
+
+int32
+FSimpleAssetLibraryTypeCatalog::GetNumEntries(FName AssetType)
+{
+    BuildIfNeeded();
+    return EntryCounts.FindRef(AssetType);
+}
+
+TArray<FName>
+FSimpleAssetLibraryTypeCatalog::GetUndeclaredTypes()
+{
+    BuildIfNeeded();
+    TArray<FName> Types;
+    for (const TPair<FName, int32>& Pair : EntryCounts)
+    {
+        if (!ConfigTypes.Contains(Pair.Key)) {
+            Types.Add(Pair.Key);
+        }
+    }
+    return SortedByName(MoveTemp(Types));
+}
+
+TArray<FName>
+FSimpleAssetLibraryTypeCatalog::GetUnusedTypes()
+{
+    BuildIfNeeded();
+    TArray<FName> Types;
+    for (const FName Type : ConfigTypes)
+    {
+        if (!EntryCounts.Contains(Type)) {
+            Types.Add(Type);
+        }
+    }
+    return Types;
+}
+
+FLinearColor
+FSimpleAssetLibraryTypeCatalog::GetColor(FName AssetType)
+{
+    if (const FLinearColor* Color = Colors.Find(AssetType)) {
+        return *Color;
+    }
+    return Colors.Add(AssetType, ComputeColor(AssetType));
+}
+
+void
+FSimpleAssetLibraryTypeCatalog::BuildIfNeeded()
+{
+    FSimpleAssetLibraryIndex& Index = FSimpleAssetLibraryIndex::Get();
+    if (!bBuilt) {
+        // the index drops and patches its rows itself, the types are counted again whenever its entries change
+        EntriesChangedHandle = Index.OnEntriesChanged().AddRaw(this, &FSimpleAssetLibraryTypeCatalog::HandleEntriesChanged);
+    }
+    if (!bBuilt || CountedStoreRevision != Index.GetStore().GetRevision()) {
+        CountEntries();
+    }
+}
+
+void
+FSimpleAssetLibraryTypeCatalog::CountEntries()
+{
+    const FSimpleAssetLibraryIndex& Index = FSimpleAssetLibraryIndex::Get();
+    const FSimpleAssetLibraryEntryStore& Store = Index.GetStore();
+    const FSimpleAssetLibraryNameTable& AssetTypes = Index.GetNames().AssetTypes;
+
+    // count by id first, the names are only looked up once per type
+    TArray<int32> CountsById;
+    CountsById.SetNumZeroed(AssetTypes.Num());
+    for (const int32 TypeId : Store.GetAssetTypeIds())
+    {
+        if (CountsById.IsValidIndex(TypeId)) {
+            CountsById[TypeId]++;
+        }
+    }
+    TMap<FName, int32> NewEntryCounts;
+    for (int32 TypeId = 0; TypeId < CountsById.Num(); TypeId++)
+    {
+        const FName AssetType = AssetTypes.GetName(TypeId);
+        if (CountsById[TypeId] > 0 && !AssetType.IsNone()) {
+            NewEntryCounts.FindOrAdd(AssetType) += CountsById[TypeId];
+        }
+    }
+
+    CountedStoreRevision = Store.GetRevision();
+    const bool bChanged = !bBuilt || !NewEntryCounts.OrderIndependentCompareEqual(EntryCounts);
+    bBuilt = true;
+    if (!bChanged) {
+        return;
+    }
+    EntryCounts = MoveTemp(NewEntryCounts);
+    Revision++;
+    for (const TPair<FName, int32>& Pair : EntryCounts)
+    {
+        ReportUndeclaredType(Pair.Key);
+    }
+}
+
+void
+FSimpleAssetLibraryTypeCatalog::HandleEntriesChanged()
+{
+    CountEntries();
+}
+
+void
+FSimpleAssetLibraryTypeCatalog::ReportUndeclaredType(FName AssetType)
+{
+    // the config isn't read yet while it has no types, there's nothing to compare to
+    if (ConfigTypes.IsEmpty() || ConfigTypes.Contains(AssetType) || ReportedTypes.Contains(AssetType)) {
+        return;
+    }
+    ReportedTypes.Add(AssetType);
+    UE_LOG(AssetLibrary, Warning, TEXT("The asset type '%s' is used by %d library entries but isn't in the asset_types of the Asset Library config"),
+        *AssetType.ToString(), EntryCounts.FindRef(AssetType));
+}
+
+FLinearColor
+FSimpleAssetLibraryTypeCatalog::ComputeColor(FName AssetType) const
+{
+    if (AssetType == SimpleAssetLibraryTags::All) {
+        return FLinearColor::White;
+    }
+
+    // spread the hues of the config asset types over the color wheel, hash the others
+    float Hue = 0.0f;
+    const int32 TypeIndex = ConfigTypes.Find(AssetType);
+    if (TypeIndex != INDEX_NONE) {
+        Hue = static_cast<float>(TypeIndex) / ConfigTypes.Num() * 359.0f;
+    }
+    else {
+        Hue = static_cast<float>(FCrc::StrCrc32(*AssetType.ToString().ToLower()) % 360);
+    }
+    return FLinearColor(Hue, 0.8f, 0.8f, 0.5f).HSVToLinearRGB();
+}
@@ -0,0 +1,241 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SimpleAssetLibraryUsage.h"
+#include "SimpleAssetLibrary.h"
+#include "SimpleAssetLibraryBPLibrary.h"
+#include "SimpleAssetLibraryThumbnailCache.h"
+
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+
+namespace
+{
+    // Number of the most used entries prefetched when the first window opens
+    constexpr int32 NumPrefetchedEntries = 8;
+
+    // The log is compacted once it holds this many records per entry, and at least MinCompactRecords
+    constexpr int32 CompactRecordsPerEntry = 4;
+    constexpr int32 MinCompactRecords = 256;
+
+    void SerializeRecord(FArchive& Ar, FString& PackageName, FSimpleAssetLibraryEntryUsage& Usage)
+    {
+        int64 LastUsedTicks = Usage.LastUsed.GetTicks();
+        Ar << PackageName << Usage.SpawnCount << LastUsedTicks << Usage.TotalLatencyMs;
+        Usage.LastUsed = FDateTime(LastUsedTicks);
+    }
+
+    void WriteHeader(FArchive& Ar)
+    {
+        uint32 FileMagic = FSimpleAssetLibraryUsage::Magic;
+        uint32 FileVersion = FSimpleAssetLibraryUsage::Version;
+        Ar << FileMagic << FileVersion;
+    }
+}
+
+
+FSimpleAssetLibraryUsage::FSimpleAssetLibraryUsage(const FString& InFilename)
+: Filename(InFilename)
+{
+    Read();
+}
+
+FSimpleAssetLibraryUsage::~FSimpleAssetLibraryUsage()
+{
+    WriteHandle.Reset();
+}
+
+FSimpleAssetLibraryUsage&
+FSimpleAssetLibraryUsage::Get()
+{
+    return FSimpleAssetLibraryModule::Get().GetUsage();
+}
+
+void
+FSimpleAssetLibraryUsage::RecordSpawn(FName PackageName, double LatencyMs)
+{
+    if (PackageName.IsNone()) {
+        return;
+    }
+    FSimpleAssetLibraryEntryUsage Record;
+    Record.SpawnCount = 1;
+    Record.LastUsed = FDateTime::UtcNow();
+    Record.TotalLatencyMs = LatencyMs;
+
+    FSimpleAssetLibraryEntryUsage& Usage = Usages.FindOrAdd(PackageName);
+    Usage.SpawnCount += Record.SpawnCount;
+    Usage.LastUsed = Record.LastUsed;
+    Usage.TotalLatencyMs += Record.TotalLatencyMs;
+
+    if (AppendRecord(PackageName, Record)) {
+        NumRecords++;
+    }
+}
+
+const FSimpleAssetLibraryEntryUsage*
+FSimpleAssetLibraryUsage::Find(FName PackageName) const
+{
+    return Usages.Find(PackageName);
+}
+
+TArray<FName>
+FSimpleAssetLibraryUsage::GetMostUsed(int32 MaxEntries) const
+{
+    TArray<FName> PackageNames;
+    Usages.GenerateKeyArray(PackageNames);
+    PackageNames.Sort([this](FName A, FName B)
+    {
+        const FSimpleAssetLibraryEntryUsage& UsageA = Usages.FindChecked(A);
+        const FSimpleAssetLibraryEntryUsage& UsageB = Usages.FindChecked(B);
+        return UsageA.SpawnCount != UsageB.SpawnCount ? UsageA.SpawnCount > UsageB.SpawnCount : UsageA.LastUsed > UsageB.LastUsed;
+    });
+    if (PackageNames.Num() > MaxEntries) {
+        PackageNames.SetNum(FMath::Max(MaxEntries, 0));
+    }
+    return PackageNames;
+}
+
+void
+FSimpleAssetLibraryUsage::SortByUsage(TArrayView<int32> Rows) const
+{
+    if (Usages.IsEmpty()) {
+        return;
+    }
+    const TArray<FName>& PackageNames = FSimpleAssetLibraryIndex::Get().GetStore().GetPackageNames();
+    SortByUsage(Rows, [&PackageNames](int32 Row) { return PackageNames[Row]; });
+}
+
+void
+FSimpleAssetLibraryUsage::PrefetchMostUsed()
+{
+    if (bPrefetched) {
+        return;
+    }
+    bPrefetched = true;
+
+    const FSimpleAssetLibraryEntryStore& Store = FSimpleAssetLibraryIndex::Get().GetStore();
+    for (const FName PackageName : GetMostUsed(NumPrefetchedEntries))
+    {
+        FSimpleAssetLibraryEntryHandle Handle;
+        Handle.Row = Store.Find(PackageName);
+        Handle.Serial = Store.GetSerial();
+        FSimpleAssetLibraryEntryInfo Info;
+        if (Handle.Row == INDEX_NONE || !USimpleAssetLibraryBPLibrary::GetLibraryEntryInfo(Handle, Info)) {
+            continue;
+        }
+        FSimpleAssetLibraryLoadSets::Get().Prefetch(Store.GetObjectPaths()[Handle.Row]);
+        if (UTexture2D* Thumbnail = SimpleAssetLibraryThumbnails::GetSharedLibraryThumbnailTexture(Info.AssetData)) {
+            PrefetchedThumbnails.Emplace(Thumbnail);
+        }
+    }
+}
+
+void
+FSimpleAssetLibraryUsage::Read()
+{
+    Usages.Reset();
+    NumRecords = 0;
+
+    TArray<uint8> Data;
+    if (!FFileHelper::LoadFileToArray(Data, *Filename, FILEREAD_Silent)) {
+        return;
+    }
+
+    FMemoryReader Reader(Data);
+    uint32 FileMagic = 0;
+    uint32 FileVersion = 0;
+    Reader << FileMagic << FileVersion;
+    if (Reader.IsError() || FileMagic != Magic || FileVersion != Version) {
+        UE_LOG(AssetLibrary, Warning, TEXT("Ignoring the Asset Library usage log from another version: %s"), *Filename);
+        IFileManager::Get().Delete(*Filename);
+        return;
+    }
+
+    // a record cut short by a crash ends the log, the records before it are kept
+    bool bTornRecord = false;
+    while (Reader.Tell() < Reader.TotalSize())
+    {
+        FString PackageName;
+        FSimpleAssetLibraryEntryUsage Record;
+        SerializeRecord(Reader, PackageName, Record);
+        if (Reader.IsError()) {
+            bTornRecord = true;
+            break;
+        }
+        FSimpleAssetLibraryEntryUsage& Usage = Usages.FindOrAdd(FName(*PackageName));
+        Usage.SpawnCount += Record.SpawnCount;
+        Usage.LastUsed = FMath::Max(Usage.LastUsed, Record.LastUsed);
+        Usage.TotalLatencyMs += Record.TotalLatencyMs;
+        NumRecords++;
+    }
+
+    // the torn bytes are dropped before anything is appended, the records written after them would never be read
+    if (bTornRecord) {
+        UE_LOG(AssetLibrary, Warning, TEXT("The Asset Library usage log ends with a partial record, rewriting it: %s"), *Filename);
+        Compact();
+    }
+    else if (NumRecords >= MinCompactRecords && NumRecords >= Usages.Num() * CompactRecordsPerEntry) {
+        Compact();
+    }
+}
+
+bool
+FSimpleAssetLibraryUsage::Compact()
+{
+    TArray<uint8> Data;
+    FMemoryWriter Writer(Data);
+    WriteHeader(Writer);
+    for (TPair<FName, FSimpleAssetLibraryEntryUsage>& Pair : Usages)
+    {
+        FString PackageName = Pair.Key.ToString();
+        SerializeRecord(Writer, PackageName, Pair.Value);
+    }
+
+    // through a temp file, a failed compaction leaves the log as it was
+    WriteHandle.Reset();
+    const FString TempFilename = Filename + TEXT(".tmp");
+    if (!FFileHelper::SaveArrayToFile(Data, *TempFilename) || !IFileManager::Get().Move(*Filename, *TempFilename, true, true)) {
+        UE_LOG(AssetLibrary, Warning, TEXT("Failed to compact the Asset Library usage log: %s"), *Filename);
+        IFileManager::Get().Delete(*TempFilename);
+        return false;
+    }
+    NumRecords = Usages.Num();
+    return true;
+}
+
+bool
+FSimpleAssetLibraryUsage::AppendRecord(FName PackageName, const FSimpleAssetLibraryEntryUsage& Usage)
+{
+    if (!WriteHandle) {
+        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+        PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Filename));
+        const bool bNewLog = !PlatformFile.FileExists(*Filename);
+        WriteHandle.Reset(PlatformFile.OpenWrite(*Filename, true, false));
+        if (!WriteHandle) {
+            UE_LOG(AssetLibrary, Warning, TEXT("Failed to open the Asset Library usage log: %s"), *Filename);
+            return false;
+        }
+        if (bNewLog) {
+            TArray<uint8> Header;
+            FMemoryWriter Writer(Header);
+            WriteHeader(Writer);
+            WriteHandle->Write(Header.GetData(), Header.Num());
+        }
+    }
+
+    TArray<uint8> Data;
+    FMemoryWriter Writer(Data);
+    FString PackageString = PackageName.ToString();
+    FSimpleAssetLibraryEntryUsage Record = Usage;
+    SerializeRecord(Writer, PackageString, Record);
+    if (!WriteHandle->Write(Data.GetData(), Data.Num()) || !WriteHandle->Flush()) {
+        UE_LOG(AssetLibrary, Warning, TEXT("Failed to write to the Asset Library usage log: %s"), *Filename);
+        return false;
+    }
+    return true;
+}
@@ -3,6 +3,14 @@
 #pragma once
 
 #include "Modules/ModuleManager.h"
+#include "SimpleAssetLibraryFavorites.h"
+#include "SimpleAssetLibraryIndex.h"
+#include "SimpleAssetLibraryLoadSets.h"
+#include "SimpleAssetLibraryMaterialPool.h"
+#include "SimpleAssetLibraryPrefsStore.h"
+#include "SimpleAssetLibraryQueryArena.h"
+#include "SimpleAssetLibraryTypeCatalog.h"
+#include "SimpleAssetLibraryUsage.h"
 
 class FSimpleAssetLibraryModule : public IModuleInterface
 {
@@ -11,4 +19,46 @@ public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+	/** Get the loaded SimpleAssetLibrary module */
+	static FSimpleAssetLibraryModule& Get();
+
+	/** Get the Asset Library index, it is created and initialized on first use */
+	FSimpleAssetLibraryIndex& GetIndex();
+
+	/** Get the load set estimates and prefetches of the library entries, they are created on first use */
+	FSimpleAssetLibraryLoadSets& GetLoadSets();
+
+	/** Get the recent and favorite entries of the user, they are read and pinned on first use */
+	FSimpleAssetLibraryFavorites& GetFavorites();
+
+	/** Get the user settings of the Asset Library windows, they are read on first use */
+	FSimpleAssetLibraryPrefsStore& GetPrefsStore();
+
+	/** Get the usage log of the library entries, it is read on first use */
+	FSimpleAssetLibraryUsage& GetUsage();
+
+	/** Get the asset types of the config and of the library entries, they are counted on first use */
+	FSimpleAssetLibraryTypeCatalog& GetTypeCatalog();
+
+	/** Get the pool of the thumbnail materials of the entry widgets, it is created on first use */
+	FSimpleAssetLibraryMaterialPool& GetMaterialPool();
+
+	/** Set the folder of the shared library pack, it must be set before the index is first used */
+	void SetSharedPackDirectory(const FString& Directory);
+	const FString& GetSharedPackDirectory() const { return SharedPackDirectory; }
+
+	/** Get the scratch memory of the library queries made from Python and Blueprints */
+	FSimpleAssetLibraryQueryArena& GetScriptQueryArena() { return ScriptQueryArena; }
+
+private:
+	TUniquePtr<FSimpleAssetLibraryIndex> Index;
+	TUniquePtr<FSimpleAssetLibraryLoadSets> LoadSets;
+	TUniquePtr<FSimpleAssetLibraryFavorites> Favorites;
+	TUniquePtr<FSimpleAssetLibraryPrefsStore> PrefsStore;
+	TUniquePtr<FSimpleAssetLibraryUsage> Usage;
+	TUniquePtr<FSimpleAssetLibraryTypeCatalog> TypeCatalog;
+	TUniquePtr<FSimpleAssetLibraryMaterialPool> MaterialPool;
+	FString SharedPackDirectory;
+	FSimpleAssetLibraryQueryArena ScriptQueryArena;
 };
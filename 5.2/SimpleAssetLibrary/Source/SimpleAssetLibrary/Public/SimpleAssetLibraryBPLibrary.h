@@ -3,8 +3,12 @@
 #pragma once
 
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "SimpleAssetLibraryFilter.h"
 #include "SimpleAssetLibraryBPLibrary.generated.h"
 
+class UMaterialInstanceDynamic;
+class UMaterialInterface;
+
 /* 
 *	Function library class.
 *	Each function in it is expected to be static and represents blueprint node that can be called in any blueprint.
@@ -25,6 +29,56 @@
 
 DECLARE_LOG_CATEGORY_EXTERN(AssetLibrary, Log, All);
 
+/** The library metadata values interned by the library index */
+UENUM(BlueprintType)
+enum class ESimpleAssetLibraryMetadata : uint8
+{
+	AssetType,
+	Category,
+	AddedBy
+};
+
+/** A reference to a row of the library index, it becomes stale once the index rows move */
+USTRUCT(BlueprintType)
+struct FSimpleAssetLibraryEntryHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Library")
+	int32 Row = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Library")
+	int32 Serial = 0;
+};
+
+/** The library data of an index entry, read from the index without loading the asset */
+USTRUCT(BlueprintType)
+struct FSimpleAssetLibraryEntryInfo
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Library")
+	FSimpleAssetLibraryEntryHandle Handle;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Library")
+	FAssetData AssetData;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Library")
+	FString DisplayName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Library")
+	FName AssetType;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Library")
+	FName Category;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Library")
+	FName AddedBy;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Library")
+	FName UnrealClass;
+};
+
 UCLASS()
 class USimpleAssetLibraryBPLibrary : public UBlueprintFunctionLibrary
 {
@@ -59,6 +113,211 @@ class USimpleAssetLibraryBPLibrary : public UBlueprintFunctionLibrary
 	UFUNCTION(BlueprintCallable, Category = "Asset Library | Utils")
 	static void RenderAssetThumbnailToDynamicMaterial(UMaterialInstanceDynamic* DynamicMaterial, int32& ImageWidth, int32& ImageHeight, bool& IsValid, const FAssetData& AssetData, UTexture2D* DefaultTexture);
 
+	/**  Borrow a thumbnail material from the plugin's pool rather than creating one, return it when the widget is destroyed
+	 * @param  Parent  the thumbnail material to instance, like M_asset_thumbnail
+	 * @return  a dynamic material of the parent, reused from a destroyed widget if there is one
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Utils")
+	static UMaterialInstanceDynamic* AcquireThumbnailMaterial(UMaterialInterface* Parent);
+
+	/**  Return a thumbnail material borrowed with AcquireThumbnailMaterial to the pool
+	 * @param  DynamicMaterial  the borrowed material, it mustn't be used by the widget anymore
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Utils")
+	static void ReleaseThumbnailMaterial(UMaterialInstanceDynamic* DynamicMaterial);
+
+	/**  Get the assets registered to the Asset Library from the native library index
+	 * @param  AssetType  only get the assets of this asset type, 'all' gets every type
+	 * @param  Category  only get the assets of this category, 'all' gets every category
+	 * @return  the registered assets, local assets first and then sorted by display name
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Index")
+	static TArray<FAssetData> QueryLibraryAssets(FName AssetType, FName Category);
+
+	/**  Get handles to the library index entries of the given asset type + category, no asset is loaded
+	 * @param  AssetType  only get the entries of this asset type, 'all' gets every type
+	 * @param  Category  only get the entries of this category, 'all' gets every category
+	 * @return  the entry handles, in library sort order
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Index")
+	static TArray<FSimpleAssetLibraryEntryHandle> GetLibraryEntryHandles(FName AssetType, FName Category);
+
+	/**  Get the library data of an entry handle
+	 * @param  Handle  a handle returned by GetLibraryEntryHandles
+	 * @param  Info  the library data of the entry
+	 * @return  false if the handle is stale, the entries must then be queried again
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Index")
+	static UPARAM(DisplayName = "Is Valid") bool GetLibraryEntryInfo(const FSimpleAssetLibraryEntryHandle& Handle, FSimpleAssetLibraryEntryInfo& Info);
+
+	/**  Get the library data of every entry of the given asset type + category, no asset is loaded
+	 * @param  AssetType  only get the entries of this asset type, 'all' gets every type
+	 * @param  Category  only get the entries of this category, 'all' gets every category
+	 * @return  the library data of the entries, in library sort order
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Index")
+	static TArray<FSimpleAssetLibraryEntryInfo> GetLibraryEntryInfos(FName AssetType, FName Category);
+
+	/**  Get handles to the library index entries matching a compound filter, no asset is loaded
+	 * @param  Filter  the asset types, categories, authors, classes and search text to match
+	 * @return  the entry handles, in library sort order
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Index")
+	static TArray<FSimpleAssetLibraryEntryHandle> FilterLibraryEntryHandles(const FSimpleAssetLibraryFilter& Filter);
+
+	/**  Get the library data of every entry matching a compound filter, no asset is loaded
+	 * @param  Filter  the asset types, categories, authors, classes and search text to match
+	 * @return  the library data of the entries, in library sort order
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Index")
+	static TArray<FSimpleAssetLibraryEntryInfo> FilterLibraryEntryInfos(const FSimpleAssetLibraryFilter& Filter);
+
+	/**  Count the library entries matching a compound filter
+	 * @param  Filter  the asset types, categories, authors, classes and search text to match
+	 * @return  the number of matching entries
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Index")
+	static int32 CountLibraryEntries(const FSimpleAssetLibraryFilter& Filter);
+
+	/**  Count the matching library entries of each value of a criterion, e.g. the entries per category for the category list
+	 * @param  Filter  the filter, its values for the counted criterion are ignored so every value gets a count
+	 * @param  Criterion  the criterion to count the values of
+	 * @param  Values  the values of the criterion, classes are given as their full path
+	 * @return  the number of matching entries of each value
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Index")
+	static TArray<int32> CountLibraryEntriesByValue(const FSimpleAssetLibraryFilter& Filter, ESimpleAssetLibraryFilterCriterion Criterion, TArray<FName>& Values);
+
+	/**  Get the categories used by the registered assets of the given asset type
+	 * @param  AssetType  the asset type to get the categories for, 'all' gets the categories of every type
+	 * @param  CategoryIds  the interned id of each returned category
+	 * @return  the category names, in id order
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Index")
+	static TArray<FName> GetLibraryCategories(FName AssetType, TArray<int32>& CategoryIds);
+
+	/**  Get every interned value of a library metadata, the index of a value in the returned list is its id
+	 * @param  Metadata  the library metadata to get the values of
+	 * @return  the interned values, the first one (id 0) is always None
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Index")
+	static TArray<FName> GetLibraryMetadataValues(ESimpleAssetLibraryMetadata Metadata);
+
+	/**  Get the interned id of a library metadata value
+	 * @param  Metadata  the library metadata the value belongs to
+	 * @param  Value  the metadata value
+	 * @return  the id of the value, -1 if no registered asset uses it
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Index")
+	static int32 GetLibraryMetadataId(ESimpleAssetLibraryMetadata Metadata, FName Value);
+
+	/**  Update the library index for a package after its Asset Library metadata changed
+	 * @param  PackageName  the long package name of the asset that was registered or unregistered
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Index")
+	static void RefreshLibraryEntry(FName PackageName);
+
+	/**  Rebuild the library index from the Asset Registry and rewrite the manifest in Saved/
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Index")
+	static void RebuildLibraryIndex();
+
+	/**  Get how far the Asset Registry is in discovering assets, the library is missing entries until it's done
+	 * @param  Progress  the fraction of the assets discovered so far, 1 once it's done
+	 * @return  whether the discovery is still running
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Index")
+	static UPARAM(DisplayName = "Is Discovering") bool GetLibraryDiscoveryProgress(float& Progress);
+
+	/**  Get how many thumbnail textures the shown entries share, entries with identical thumbnails show one texture
+	 * @param  NumEntries  the library entries showing a thumbnail
+	 * @param  NumTextures  the distinct thumbnail textures they show
+	 * @return  the fraction of the entries that didn't need a texture of their own
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Index")
+	static UPARAM(DisplayName = "Dedup Ratio") float GetLibraryThumbnailDedup(int32& NumEntries, int32& NumTextures);
+
+	/**  Set the folder of the shared library pack distributed with the project
+	 * @param  Directory  the absolute path of the pack folder, empty to disable the shared pack
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Index")
+	static void SetSharedLibraryPackDirectory(const FString& Directory);
+
+	/**  Export the library index and thumbnails as a read-only pack the whole team can share
+	 * @param  Directory  the absolute path of the pack folder
+	 * @return  whether the pack was written
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Index")
+	static UPARAM(DisplayName = "Success") bool ExportSharedLibraryPack(const FString& Directory);
+
+	/**  Estimate what placing a library entry loads: its package and the closure of its hard dependencies
+	 * @param  PackageName  the long package name of the library entry
+	 * @param  NumDependencies  the number of packages loaded with the entry, script packages are left out
+	 * @param  DiskSize  the size on disk of the entry package and its dependencies, in bytes
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Loading")
+	static void GetLibraryEntryLoadSet(FName PackageName, int32& NumDependencies, int64& DiskSize);
+
+	/**  Describe the load set of a library entry for its tooltip, e.g. "Loads 152 dependencies, 312.4 MB on disk"
+	 * @param  PackageName  the long package name of the library entry
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Loading")
+	static FText GetLibraryEntryLoadSetText(FName PackageName);
+
+	/**  Async load a library entry and its dependencies so placing it doesn't stall the editor
+	 * @param  PackageName  the long package name of the library entry
+	 * @return  false if the package isn't a library entry or couldn't be requested
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Loading")
+	static UPARAM(DisplayName = "Started") bool PrefetchLibraryEntry(FName PackageName);
+
+	/**  Check whether a prefetched library entry finished loading
+	 * @param  PackageName  the long package name of the library entry
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Loading")
+	static bool IsLibraryEntryPrefetched(FName PackageName);
+
+	/** Get the library entries the user placed recently, the most recent first. No query is made, they are already loaded */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Favorites")
+	static TArray<FSimpleAssetLibraryEntryInfo> GetRecentLibraryEntries();
+
+	/** Get the favorite library entries of the user, no query is made and they are already loaded */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Favorites")
+	static TArray<FSimpleAssetLibraryEntryInfo> GetFavoriteLibraryEntries();
+
+	/**  Add a library entry to the user's favorites or remove it, the favorites are kept loaded
+	 * @param  PackageName  the long package name of the library entry
+	 * @param  bFavorite  whether the entry is a favorite
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Favorites")
+	static void SetLibraryEntryFavorite(FName PackageName, bool bFavorite);
+
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Favorites")
+	static bool IsLibraryEntryFavorite(FName PackageName);
+
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Favorites")
+	static void ClearRecentLibraryEntries();
+
+	/**  Get how much a library entry was placed, from the local usage log
+	 * @param  PackageName  the long package name of the library entry
+	 * @param  SpawnCount  the number of times the entry was placed
+	 * @param  LastUsed  when the entry was last placed, in UTC
+	 * @param  AverageLatencyMs  the average time it took to place the entry
+	 * @return  false if the entry was never placed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Usage")
+	static bool GetLibraryEntryUsage(FName PackageName, int32& SpawnCount, FDateTime& LastUsed, float& AverageLatencyMs);
+
+	/**  Get the most placed library entries, ties by the most recent use. No query is made
+	 * @param  MaxEntries  the maximum number of entries to return
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Usage")
+	static TArray<FSimpleAssetLibraryEntryInfo> GetMostUsedLibraryEntries(int32 MaxEntries = 16);
+
+	/** Get the library entries that were never placed, in the order of the library */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Usage")
+	static TArray<FSimpleAssetLibraryEntryInfo> GetUnusedLibraryEntries();
+
 	/**  log a message to the AssetLibrary category
 	 * @param  Message  the message to log
 	 */
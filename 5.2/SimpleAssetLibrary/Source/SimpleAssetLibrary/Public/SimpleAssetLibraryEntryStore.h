@@ -0,0 +1,237 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+
+/* The metadata names used by the Asset Library, these match the names in metadata.py */
+namespace SimpleAssetLibraryTags
+{
+	extern SIMPLEASSETLIBRARY_API const FName ManagedAsset;
+	extern SIMPLEASSETLIBRARY_API const FName AssetType;
+	extern SIMPLEASSETLIBRARY_API const FName AssetCategory;
+	extern SIMPLEASSETLIBRARY_API const FName DisplayName;
+	extern SIMPLEASSETLIBRARY_API const FName AddedBy;
+
+	/** the value the UI uses to query every asset type or category */
+	extern SIMPLEASSETLIBRARY_API const FName All;
+}
+
+
+/* Interned metadata values, each distinct value gets a small integer id and id 0 is always None */
+class SIMPLEASSETLIBRARY_API FSimpleAssetLibraryNameTable
+{
+public:
+	FSimpleAssetLibraryNameTable();
+
+	/** Get the id of the given value, adding it to the table if needed */
+	int32 Intern(FName Name);
+
+	/** Get the id of the given value, INDEX_NONE if it isn't in the table */
+	int32 Find(FName Name) const;
+
+	FName GetName(int32 Id) const { return Names.IsValidIndex(Id) ? Names[Id] : NAME_None; }
+
+	/** all the values of the table, a value's index is its id */
+	const TArray<FName>& GetNames() const { return Names; }
+	int32 Num() const { return Names.Num(); }
+
+	void Reset();
+
+	friend FArchive& operator<<(FArchive& Ar, FSimpleAssetLibraryNameTable& Table);
+
+private:
+	TArray<FName> Names;
+	TMap<FName, int32> Ids;
+};
+
+
+/* The name tables of the library metadata values that are interned */
+struct SIMPLEASSETLIBRARY_API FSimpleAssetLibraryNames
+{
+	FSimpleAssetLibraryNameTable AssetTypes;
+	FSimpleAssetLibraryNameTable Categories;
+	FSimpleAssetLibraryNameTable Authors;
+
+	void Reset();
+
+	friend FArchive& operator<<(FArchive& Ar, FSimpleAssetLibraryNames& Names);
+};
+
+
+/* Location of a compressed thumbnail in the local thumbnail cache or the shared library pack */
+struct SIMPLEASSETLIBRARY_API FSimpleAssetLibraryThumbnailRef
+{
+	int64 Offset = INDEX_NONE;
+	int32 Size = 0;
+	int32 Width = 0;
+	int32 Height = 0;
+
+	bool IsSet() const { return Offset != INDEX_NONE; }
+
+	friend FArchive& operator<<(FArchive& Ar, FSimpleAssetLibraryThumbnailRef& Ref);
+};
+
+
+/* Size, modification time and content hash of the package file of an entry, the unchanged packages aren't indexed again */
+struct SIMPLEASSETLIBRARY_API FSimpleAssetLibraryPackageFingerprint
+{
+	int64 Size = INDEX_NONE;
+
+	/** the modification time of the file, in UTC ticks */
+	int64 Timestamp = 0;
+
+	/** the hash of the file content, 0 until it was needed once */
+	uint64 Hash = 0;
+
+	bool IsSet() const { return Size != INDEX_NONE; }
+
+	/**  Read the size and time of a package file, the content is only hashed if asked for
+	 * @return  an unset fingerprint if the package file doesn't exist
+	 */
+	static FSimpleAssetLibraryPackageFingerprint FromPackage(FName PackageName, bool bHash);
+
+	/**  Check whether a package file is unchanged since this fingerprint was taken
+	 * the content is only hashed if the file has the same size but another time, a sync rewrites files it didn't change
+	 * @param  OutCurrent  the fingerprint of the file now, its hash is set if the file changed
+	 */
+	bool MatchesPackage(FName PackageName, FSimpleAssetLibraryPackageFingerprint& OutCurrent) const;
+
+	friend FArchive& operator<<(FArchive& Ar, FSimpleAssetLibraryPackageFingerprint& Fingerprint);
+};
+
+
+enum class ESimpleAssetLibraryEntryFlags : uint8
+{
+	None = 0,
+
+	/** the thumbnail lives in the shared library pack rather than the local thumbnail cache */
+	SharedThumbnail = 1 << 0,
+};
+ENUM_CLASS_FLAGS(ESimpleAssetLibraryEntryFlags);
+
+
+/* A single library entry, used to build or update a row of the entry store */
+struct SIMPLEASSETLIBRARY_API FSimpleAssetLibraryEntry
+{
+	FName PackageName;
+	FSoftObjectPath ObjectPath;
+	FTopLevelAssetPath AssetClassPath;
+	FString DisplayName;
+
+	/** ids of the metadata values in the store's name tables */
+	int32 AssetTypeId = 0;
+	int32 CategoryId = 0;
+	int32 AddedById = 0;
+
+	/** lowercase sort key: local (/Game/) assets first, then the display name, then the full asset name */
+	FString SortKey;
+
+	FSimpleAssetLibraryThumbnailRef Thumbnail;
+	ESimpleAssetLibraryEntryFlags Flags = ESimpleAssetLibraryEntryFlags::None;
+
+	/** the package file the entry was indexed from, unset until the index reads it */
+	FSimpleAssetLibraryPackageFingerprint Fingerprint;
+
+	/**  Create the entry for the given asset, its metadata values are interned in the given name tables
+	 * @return  false if the asset isn't managed by the Asset Library
+	 */
+	static bool FromAssetData(const FAssetData& AssetData, FSimpleAssetLibraryNames& Names, FSimpleAssetLibraryEntry& OutEntry);
+
+	/** whether the library data of both entries match (ignores the thumbnail), both must use the same name tables */
+	bool HasSameLibraryData(const FSimpleAssetLibraryEntry& Other) const;
+
+	/** use the cached thumbnail of another entry for this one */
+	void CopyThumbnailFrom(const FSimpleAssetLibraryEntry& Other);
+};
+
+
+/*
+*	Structure-of-arrays storage of the library entries.
+*
+*	Each column holds one field of every entry, so filter and sort passes only touch the fields they
+*	need and no per-entry objects are allocated. Rows are kept in sort order by the owner calling Sort()
+*	after adding or updating rows. Any change that moves existing rows bumps the serial number, which
+*	lets entry handles held by widgets detect they are stale.
+*/
+class SIMPLEASSETLIBRARY_API FSimpleAssetLibraryEntryStore
+{
+public:
+	FSimpleAssetLibraryEntryStore();
+
+	int32 Num() const { return PackageNames.Num(); }
+	int32 GetSerial() const { return Serial; }
+
+	/** changes whenever the content of any row changes, caches built from the columns compare it */
+	int32 GetRevision() const { return Revision; }
+
+	/** Get the row of the given package, INDEX_NONE if it isn't in the store */
+	int32 Find(FName PackageName) const;
+
+	/** Copy a row out of the store */
+	FSimpleAssetLibraryEntry GetEntry(int32 Row) const;
+
+	/** Append a new row, Sort() must be called once all rows are added */
+	void Add(FSimpleAssetLibraryEntry&& Entry);
+
+	/** Replace a row, Sort() must be called if its sort key changed */
+	void Set(int32 Row, FSimpleAssetLibraryEntry&& Entry);
+
+	/** Remove the rows flagged in the given bit array */
+	void Remove(const TBitArray<>& RowsToRemove);
+	void RemoveAt(int32 Row);
+
+	void SetThumbnail(int32 Row, const FSimpleAssetLibraryThumbnailRef& Thumbnail, bool bShared);
+
+	/** Record the package file a row was indexed from, the content of the row is unchanged */
+	void SetFingerprint(int32 Row, const FSimpleAssetLibraryPackageFingerprint& Fingerprint) { Fingerprints[Row] = Fingerprint; }
+
+	/** Put the rows in sort key order */
+	void Sort();
+
+	/** Remove every row and reset the name tables */
+	void Reset();
+
+	FSimpleAssetLibraryNames& GetNames() { return Names; }
+	const FSimpleAssetLibraryNames& GetNames() const { return Names; }
+
+	/* Columns */
+	const TArray<FName>& GetPackageNames() const { return PackageNames; }
+	const TArray<FSoftObjectPath>& GetObjectPaths() const { return ObjectPaths; }
+	const TArray<FTopLevelAssetPath>& GetAssetClassPaths() const { return AssetClassPaths; }
+	const TArray<FString>& GetDisplayNames() const { return DisplayNames; }
+	const TArray<FString>& GetSortKeys() const { return SortKeys; }
+	const TArray<int32>& GetAssetTypeIds() const { return AssetTypeIds; }
+	const TArray<int32>& GetCategoryIds() const { return CategoryIds; }
+	const TArray<int32>& GetAddedByIds() const { return AddedByIds; }
+	const TArray<FSimpleAssetLibraryThumbnailRef>& GetThumbnails() const { return Thumbnails; }
+	const TArray<ESimpleAssetLibraryEntryFlags>& GetFlags() const { return Flags; }
+	const TArray<FSimpleAssetLibraryPackageFingerprint>& GetFingerprints() const { return Fingerprints; }
+
+	friend FArchive& operator<<(FArchive& Ar, FSimpleAssetLibraryEntryStore& Store);
+
+private:
+	/** keep the given rows in the given order, every other row is removed */
+	void Reorder(const TArray<int32>& Rows);
+	void RebuildLookup();
+
+	FSimpleAssetLibraryNames Names;
+
+	TArray<FName> PackageNames;
+	TArray<FSoftObjectPath> ObjectPaths;
+	TArray<FTopLevelAssetPath> AssetClassPaths;
+	TArray<FString> DisplayNames;
+	TArray<FString> SortKeys;
+	TArray<int32> AssetTypeIds;
+	TArray<int32> CategoryIds;
+	TArray<int32> AddedByIds;
+	TArray<FSimpleAssetLibraryThumbnailRef> Thumbnails;
+	TArray<ESimpleAssetLibraryEntryFlags> Flags;
+	TArray<FSimpleAssetLibraryPackageFingerprint> Fingerprints;
+
+	TMap<FName, int32> RowByPackage;
+	int32 Serial = 0;
+	int32 Revision = 0;
+};
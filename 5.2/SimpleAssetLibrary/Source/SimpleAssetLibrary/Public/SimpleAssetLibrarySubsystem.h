@@ -0,0 +1,338 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "EditorSubsystem.h"
+#include "SimpleAssetLibraryFilter.h"
+#include "SimpleAssetLibrarySubsystem.generated.h"
+
+class AActor;
+class UEditorUtilityWidget;
+class UEditorUtilityWidgetBlueprint;
+class UMaterialInstanceDynamic;
+class UUserWidget;
+
+
+/** How assets are placed in the level by SpawnAssetInViewport */
+USTRUCT(BlueprintType)
+struct FSimpleAssetLibrarySpawnSettings
+{
+	GENERATED_BODY()
+
+	/** rotate the actor to the normal of the surface under the mouse */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Library")
+	bool bAlignToSurface = true;
+
+	/** ignore the actors placed from the Asset Library when looking for the surface under the mouse */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Library")
+	bool bIgnorePlacedAssets = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Library")
+	bool bSelectAfterSpawning = true;
+
+	/** the distance from the camera to look for a surface, in cm */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Library")
+	float MaxDistance = 10000.0f;
+};
+
+/** The user settings of the Asset Library window, saved to Saved/Config/asset_library_prefs.json */
+USTRUCT(BlueprintType)
+struct FSimpleAssetLibraryPrefs
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Library")
+	FSimpleAssetLibrarySpawnSettings SpawnSettings;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Library")
+	bool bShowAddEntryButton = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Library")
+	bool bShowDeleteButton = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Library")
+	float EntrySize = 1.0f;
+
+	/** the asset type, category and search text shown when the window was closed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Library")
+	FString AssetType;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Library")
+	FString Category;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Library")
+	FString SearchText;
+};
+
+
+/** What an Asset Library window has to update, the updates marked during a frame are made once at its end */
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class ESimpleAssetLibraryPanelDirty : uint8
+{
+	None = 0 UMETA(Hidden),
+
+	/** the asset type or the library entries changed, the entries are got again */
+	Type = 1 << 0,
+
+	/** the category or the search text changed, the entries are filtered again */
+	Category = 1 << 1,
+	Filter = 1 << 2,
+
+	/** the entry size changed, the entries are resized */
+	Size = 1 << 3,
+};
+ENUM_CLASS_FLAGS(ESimpleAssetLibraryPanelDirty);
+
+
+/*
+*	The Asset Library operations, implemented natively for the Asset Library window and scripts.
+*
+*	Registration, the asset type + category lists, the entries of the window, their filtering,
+*	placing assets in the level and the user settings all live here. The Python commands module
+*	forwards to this subsystem, so a window interaction costs one call instead of Python code per entry.
+*/
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnSimpleAssetLibraryChanged);
+
+UCLASS()
+class SIMPLEASSETLIBRARY_API USimpleAssetLibrarySubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Get the subsystem of the running editor, nullptr outside of the editor */
+	static USimpleAssetLibrarySubsystem* Get();
+
+	/**  Get the asset types from the Asset Library config
+	 * @param  bIncludeAllOption  whether to start the list with an 'all' option
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Subsystem")
+	TArray<FString> GetAvailableAssetTypes(bool bIncludeAllOption = true);
+
+	/**  Get the categories of an asset type: the default categories of the config and the ones added by users
+	 * @param  AssetType  the asset type, 'all' gets the categories of every type without the default ones
+	 * @param  bIncludeAllOption  whether to start the list with an 'all' option
+	 * @return  the sorted categories
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Subsystem")
+	TArray<FString> GetAvailableAssetCategories(const FString& AssetType, bool bIncludeAllOption = true);
+
+	/** the categories every asset type offers, users can add their own when registering assets */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Subsystem")
+	TArray<FString> GetDefaultCategories();
+
+	/** the outliner folder of the actors placed from the Asset Library, empty to place them at the root */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Subsystem")
+	FString GetPlacedActorFolder();
+
+	/** the absolute path of the shared library pack folder, empty if the config disables it */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Subsystem")
+	FString GetSharedLibraryPackDirectory();
+
+	/** the content roots whose package headers are read from disk while the Asset Registry is still discovering assets */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Subsystem")
+	TArray<FString> GetLibraryScanRoots();
+
+	/**  Get the color of an asset type, used for visual context in the window. It is computed once per type
+	 * @param  AssetType  the asset type, 'all' is white, types missing from the config get a color from their name
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Subsystem")
+	FLinearColor GetAssetTypeColor(const FString& AssetType);
+
+	/** Get the asset types used by library entries that the Asset Library config doesn't declare */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Subsystem")
+	TArray<FString> GetUndeclaredAssetTypes();
+
+	/** Get the asset types declared in the Asset Library config that no library entry uses */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Subsystem")
+	TArray<FString> GetUnusedAssetTypes();
+
+	/** Read the Asset Library config again, <project>/Config/simple_asset_library_settings.json first */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Subsystem")
+	void ReloadConfig();
+
+	/**  Register an asset to the Asset Library: write the library metadata to the asset and save it
+	 * @param  Asset  the asset to register
+	 * @param  AssetType  the asset type of the entry
+	 * @param  Category  the category of the entry
+	 * @param  DisplayName  the name shown in the Asset Library
+	 * @return  whether the asset was saved with its metadata
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Subsystem")
+	bool RegisterAsset(UObject* Asset, const FString& AssetType, const FString& Category, const FString& DisplayName);
+
+	/**  Remove an asset from the Asset Library: remove the library metadata from the asset and save it
+	 * @param  Asset  the asset to unregister
+	 * @return  whether the asset was saved without its metadata
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Subsystem")
+	bool UnregisterAsset(UObject* Asset);
+
+	/**  Get the Asset Library metadata of an asset
+	 * @param  Asset  the asset to get the metadata of
+	 * @param  AssetType  the asset type of the entry, empty if unregistered
+	 * @param  Category  the category of the entry, empty if unregistered
+	 * @param  DisplayName  the name shown in the Asset Library, defaults to the asset name in title case
+	 * @return  whether the asset is registered to the Asset Library
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Subsystem")
+	UPARAM(DisplayName = "Is Managed") bool GetAssetLibraryData(UObject* Asset, FString& AssetType, FString& Category, FString& DisplayName);
+
+	/**  Create the entry data objects of the Asset Library window from the library index, no asset is loaded
+	 * @param  EntryDataClass  the entry data class of the window, its properties are set by name
+	 * @param  AssetType  the asset type to get the entries of, 'all' gets every type
+	 * @param  bAddNewEntryButton  whether to end the list with the 'Add Entry' button entry
+	 * @param  Panel  the window the entries are for. If the entry data class has a `thumbnail_material` property each
+	 *                entry gets a pooled thumbnail material, the window returns them when it gets its entries again or closes
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Subsystem")
+	TArray<UObject*> GetGuiEntries(TSubclassOf<UObject> EntryDataClass, const FString& AssetType, bool bAddNewEntryButton, UEditorUtilityWidget* Panel = nullptr);
+
+	/**  Keep the entry data objects matching a filter, the 'Add Entry' button entry always matches
+	 * @param  Entries  entry data objects created by GetGuiEntries
+	 * @param  Filter  the criteria and search text to match, evaluated by the library index
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Subsystem")
+	TArray<UObject*> FilterGuiEntries(const TArray<UObject*>& Entries, const FSimpleAssetLibraryFilter& Filter);
+
+	/**  Place an asset in the level under the mouse, on the surface under it if any
+	 * @param  Asset  the asset to spawn an actor from
+	 * @param  DisplayName  the label of the new actor
+	 * @param  Settings  how to place the actor
+	 * @return  the new actor, nullptr if the mouse isn't over a viewport or the asset can't be spawned
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Subsystem")
+	AActor* SpawnAssetInViewport(UObject* Asset, const FString& DisplayName, const FSimpleAssetLibrarySpawnSettings& Settings);
+
+	/**  Save the user settings of an Asset Library window
+	 * The spawn and display settings are shared by every window, the asset type, category and search text are per window.
+	 * The file is written in the background shortly after, the saves made meanwhile are written together.
+	 * @param  Prefs  the settings to save
+	 * @param  PanelName  the name of the window, None for the main window
+	 * @return  whether the settings changed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Subsystem")
+	bool SaveSettings(const FSimpleAssetLibraryPrefs& Prefs, FName PanelName = NAME_None);
+
+	/**  Load the user settings of an Asset Library window
+	 * @param  PanelName  the name of the window, None for the main window
+	 * @param  Prefs  the saved settings, the defaults for the settings that were never saved
+	 * @return  false if no settings were saved yet
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Subsystem")
+	bool LoadSettings(FName PanelName, FSimpleAssetLibraryPrefs& Prefs);
+
+	/** <project>/Saved/Config/asset_library_prefs.json */
+	static FString GetPrefsFilename();
+
+	/**  Open an Asset Library window and add it to the open windows, or bring it to front if it's open
+	 * Every window has its own filter but they all show the same library index and thumbnails.
+	 * @param  PanelName  the name of the window, like Props or FX, None for the main window
+	 * @return  the widget of the window, nullptr if its tab couldn't be spawned
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Panels")
+	UEditorUtilityWidget* OpenLibraryPanel(FName PanelName = NAME_None);
+
+	/**  Add an Asset Library window to the open windows, the windows opened by OpenLibraryPanel already are
+	 * @param  Panel  the widget of the window, it is removed when it's destructed
+	 * @param  PanelName  the name of the window, None for the main window
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Panels")
+	void RegisterLibraryPanel(UEditorUtilityWidget* Panel, FName PanelName = NAME_None);
+
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Panels")
+	void UnregisterLibraryPanel(UEditorUtilityWidget* Panel);
+
+	/** the Asset Library window being constructed this frame, else the one under the mouse or with the keyboard focus, else the most recently opened one, nullptr if none is open */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Panels")
+	UEditorUtilityWidget* GetLibraryPanel();
+
+	/** the open Asset Library windows, the most recently opened last */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Panels")
+	TArray<UEditorUtilityWidget*> GetLibraryPanels();
+
+	/** the name of an open Asset Library window, None for the main window */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Panels")
+	FName GetLibraryPanelName(UEditorUtilityWidget* Panel) const;
+
+	/**  Mark what an Asset Library window has to update, it's updated once at the end of the frame
+	 * Restoring a window sets its type, category, search text and size one after the other, that costs a single
+	 * query and layout. Until then the entries the window asks for are empty, see IsLibraryPanelUpdatePending.
+	 * @param  Panel  the window to update
+	 * @param  Dirty  the ESimpleAssetLibraryPanelDirty flags of what changed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Panels")
+	void MarkLibraryPanelDirty(UEditorUtilityWidget* Panel, UPARAM(meta = (Bitmask, BitmaskEnum = "/Script/SimpleAssetLibrary.ESimpleAssetLibraryPanelDirty")) int32 Dirty);
+
+	/** whether a window has an update marked for the end of the frame, the entries it asks for meanwhile would be replaced anyway */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Panels")
+	bool IsLibraryPanelUpdatePending(UEditorUtilityWidget* Panel) const;
+
+	/** Make the updates marked on the open windows now rather than at the end of the frame */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Panels")
+	void FlushLibraryPanels();
+
+	/** Broadcast when library entries were renamed, moved or deleted in the editor, the open windows get their entries again */
+	UPROPERTY(BlueprintAssignable, Category = "Asset Library | Panels")
+	FOnSimpleAssetLibraryChanged OnLibraryEntriesChanged;
+
+private:
+	void LoadConfigIfNeeded();
+
+	/**  Get the widget blueprint of the Asset Library window
+	 * @param  bLoad  whether to load it, otherwise nullptr is returned if it isn't loaded yet
+	 */
+	UEditorUtilityWidgetBlueprint* GetLibraryPanelBlueprint(bool bLoad);
+	void HandlePanelDestructed(UUserWidget* Panel);
+	void HandleEntriesChanged();
+	void HandleEndFrame();
+	void RemoveClosedPanels();
+
+	/**  Register the window the blueprint created last, when it's being constructed or was restored with the editor layout
+	 * @return  the window if it was registered by this call, nullptr if it was already registered or there is none
+	 */
+	UEditorUtilityWidget* RegisterCreatedPanel();
+
+	struct FLibraryPanel
+	{
+		/** weak, a closed window is gone once it's garbage collected */
+		TWeakObjectPtr<UEditorUtilityWidget> Widget;
+		FName Name;
+
+		/** the updates marked for the end of the frame */
+		ESimpleAssetLibraryPanelDirty Dirty = ESimpleAssetLibraryPanelDirty::None;
+
+		/** the pooled thumbnail materials of the window's entries, weak, the entries hold them */
+		TArray<TWeakObjectPtr<UMaterialInstanceDynamic>> ThumbnailMaterials;
+	};
+	int32 FindPanel(const UEditorUtilityWidget* Widget) const;
+
+	/** Return the thumbnail materials of a window's entries to the pool, when its entries are replaced or it closes */
+	static void ReleaseThumbnailMaterials(FLibraryPanel& Panel);
+
+	/** the open windows, the most recently opened last */
+	TArray<FLibraryPanel> LibraryPanels;
+
+	/** the name of the window OpenLibraryPanel is spawning */
+	FName SpawningPanelName;
+
+	/** the window registered while it was being constructed, the calls made from its construct act on it rather than on the hovered one */
+	TWeakObjectPtr<UEditorUtilityWidget> ConstructingPanel;
+	uint64 ConstructingPanelFrame = 0;
+
+	/** the windows are notified of the index changes once the first one is registered */
+	FDelegateHandle EntriesChangedHandle;
+
+	/** bound while a window has updates marked, they're made at the end of the frame */
+	FDelegateHandle EndFrameHandle;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UEditorUtilityWidgetBlueprint> LibraryPanelBlueprint;
+
+	/** the values of the Asset Library config, see Config/simple_asset_library_settings.json */
+	TArray<FString> ConfigAssetTypes;
+	TArray<FString> ConfigDefaultCategories;
+	FString ConfigPlacedActorFolder;
+	FString ConfigSharedLibraryPack;
+	TArray<FString> ConfigLibraryScanRoots;
+	bool bConfigLoaded = false;
+};
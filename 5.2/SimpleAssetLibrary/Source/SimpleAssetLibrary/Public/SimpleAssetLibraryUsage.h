@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Algo/StableSort.h"
+#include "UObject/StrongObjectPtr.h"
+
+class IFileHandle;
+class UTexture2D;
+
+
+/* How much a library entry was used, aggregated from the usage log */
+struct FSimpleAssetLibraryEntryUsage
+{
+	/** the number of times the entry was placed */
+	int32 SpawnCount = 0;
+
+	/** when the entry was last placed, in UTC */
+	FDateTime LastUsed;
+
+	/** the total time spent placing the entry in the level, in ms */
+	double TotalLatencyMs = 0.0;
+
+	double GetAverageLatencyMs() const { return SpawnCount > 0 ? TotalLatencyMs / SpawnCount : 0.0; }
+};
+
+
+/*
+*	Local usage log of the library entries, kept in Saved/SimpleAssetLibrary/LibraryUsage.bin.
+*
+*	Every placement appends a record to the log, the log is replayed into per-entry aggregates when
+*	it's first read. A log that grew much larger than its aggregates is rewritten with one record per
+*	entry. The aggregates rank the search results and the most used entries are prefetched with
+*	their thumbnails when the first Asset Library window opens.
+*
+*	Record: package name, count, last use (UTC ticks), total latency in ms. A placement is a record
+*	with a count of 1, a rewritten log holds one record with the totals per entry.
+*/
+class SIMPLEASSETLIBRARY_API FSimpleAssetLibraryUsage
+{
+public:
+	static constexpr uint32 Magic = 0x53414C55; // 'SALU'
+	static constexpr uint32 Version = 1;
+
+	explicit FSimpleAssetLibraryUsage(const FString& InFilename);
+	~FSimpleAssetLibraryUsage();
+
+	/** Get the usage log owned by the SimpleAssetLibrary module */
+	static FSimpleAssetLibraryUsage& Get();
+
+	/**  Record a placement of a library entry
+	 * @param  PackageName  the long package name of the placed entry
+	 * @param  LatencyMs  the time it took to place the entry in the level
+	 */
+	void RecordSpawn(FName PackageName, double LatencyMs);
+
+	/** the usage of an entry, nullptr if it was never placed */
+	const FSimpleAssetLibraryEntryUsage* Find(FName PackageName) const;
+
+	/** the usage of every entry ever placed, by package name */
+	const TMap<FName, FSimpleAssetLibraryEntryUsage>& GetUsages() const { return Usages; }
+
+	/**  Get the most placed entries
+	 * @param  MaxEntries  the maximum number of entries to return
+	 * @return  the package names, the most placed first, ties by the most recent use
+	 */
+	TArray<FName> GetMostUsed(int32 MaxEntries) const;
+
+	/**  Order rows of the library by usage, the most placed first. The rows of the entries used as often keep their order
+	 * @param  Rows  rows of the library index store, sorted in place
+	 */
+	void SortByUsage(TArrayView<int32> Rows) const;
+
+	/**  Order items by the usage of their entry, the most placed first. The items of the entries used as often keep their order
+	 * @param  Items  the items to sort in place
+	 * @param  GetPackageName  returns the long package name of an item's entry
+	 */
+	template <typename ItemType, typename GetPackageNameType>
+	void SortByUsage(TArrayView<ItemType> Items, GetPackageNameType GetPackageName) const
+	{
+		if (Usages.IsEmpty() || Items.Num() < 2) {
+			return;
+		}
+
+		// look the counts up once per item rather than once per comparison
+		TArray<TPair<int32, ItemType>> CountedItems;
+		CountedItems.Reserve(Items.Num());
+		for (ItemType& Item : Items)
+		{
+			const FSimpleAssetLibraryEntryUsage* Usage = Usages.Find(GetPackageName(Item));
+			CountedItems.Emplace(Usage ? Usage->SpawnCount : 0, MoveTemp(Item));
+		}
+		Algo::StableSortBy(CountedItems, [](const TPair<int32, ItemType>& CountedItem) { return -CountedItem.Key; });
+		for (int32 Index = 0; Index < Items.Num(); Index++)
+		{
+			Items[Index] = MoveTemp(CountedItems[Index].Value);
+		}
+	}
+
+	/** Prefetch the most used entries and keep their thumbnails, done once */
+	void PrefetchMostUsed();
+
+	const FString& GetFilename() const { return Filename; }
+
+private:
+	void Read();
+	bool Compact();
+	bool AppendRecord(FName PackageName, const FSimpleAssetLibraryEntryUsage& Usage);
+
+	FString Filename;
+	TMap<FName, FSimpleAssetLibraryEntryUsage> Usages;
+	TUniquePtr<IFileHandle> WriteHandle;
+
+	/** the number of records in the log, it is compacted when they outnumber the entries by far */
+	int32 NumRecords = 0;
+	bool bPrefetched = false;
+
+	/** the thumbnails of the prefetched entries */
+	TArray<TStrongObjectPtr<UTexture2D>> PrefetchedThumbnails;
+};
@@ -38,11 +38,18 @@ public class SimpleAssetLibrary : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"UMG",
 				"InputCore",
 				"ImageWrapper",
 				"UnrealEd",
 				"EditorFramework",
-				"ApplicationCore"
+				"EditorSubsystem",
+				"Blutility",
+				"ApplicationCore",
+				"Json",
+				"Projects",
+				"RenderCore",
+				"RHI"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
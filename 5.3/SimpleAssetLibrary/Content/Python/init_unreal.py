@@ -2,6 +2,7 @@
 import unreal
 
 from simple_asset_library import (
+    config,
     menus,
     metadata
 )
@@ -9,6 +10,17 @@ from simple_asset_library import (
 
 metadata.register_metadata_names()
 
+# Use the team's shared library pack if the project provides one
+unreal.SimpleAssetLibraryBPLibrary.set_shared_library_pack_directory(config.get_config_shared_library_pack())
+
+# Keep the open windows in sync with the assets renamed, moved or deleted in the editor
+def _on_library_entries_changed():
+    from simple_asset_library import commands
+    commands.refresh_open_asset_libraries()
+
+
+unreal.get_editor_subsystem(unreal.SimpleAssetLibrarySubsystem).on_library_entries_changed.add_callable(_on_library_entries_changed)
+
 # Add the Asset Library button to the Content Browser
 content_browser_menu = unreal.ToolMenus.get().find_menu("ContentBrowser.ToolBar")
 menus.AssetLibraryLauncher(content_browser_menu, "")
@@ -1,9 +1,25 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "SimpleAssetLibrary.h"
+#include "SimpleAssetLibraryBPLibrary.h"
+#include "SimpleAssetLibraryStats.h"
+#include "SimpleAssetLibrarySubsystem.h"
+
+#include "Misc/Paths.h"
 
 #define LOCTEXT_NAMESPACE "FSimpleAssetLibraryModule"
 
+DEFINE_STAT(STAT_SimpleAssetLibrary_Query);
+DEFINE_STAT(STAT_SimpleAssetLibrary_FilterByName);
+DEFINE_STAT(STAT_SimpleAssetLibrary_CategoryFacets);
+DEFINE_STAT(STAT_SimpleAssetLibrary_CountByValue);
+DEFINE_STAT(STAT_SimpleAssetLibrary_BuildFilterBits);
+DEFINE_STAT(STAT_SimpleAssetLibrary_LoadSet);
+DEFINE_STAT(STAT_SimpleAssetLibrary_ScanPackages);
+DEFINE_STAT(STAT_SimpleAssetLibrary_ArenaAllocations);
+DEFINE_STAT(STAT_SimpleAssetLibrary_ArenaHeapAllocations);
+DEFINE_STAT(STAT_SimpleAssetLibrary_ArenaMemory);
+
 void FSimpleAssetLibraryModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
@@ -14,7 +30,99 @@ void FSimpleAssetLibraryModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
-	
+	// the favorites hold pins on the load sets, they and the type catalog listen to the index
+	Favorites.Reset();
+	TypeCatalog.Reset();
+	if (Index.IsValid())
+	{
+		Index->SaveManifest();
+		Index.Reset();
+	}
+	Usage.Reset();
+	MaterialPool.Reset();
+	LoadSets.Reset();
+
+	// Pending settings are written before the editor exits
+	PrefsStore.Reset();
+}
+
+FSimpleAssetLibraryModule& FSimpleAssetLibraryModule::Get()
+{
+	return FModuleManager::LoadModuleChecked<FSimpleAssetLibraryModule>("SimpleAssetLibrary");
+}
+
+FSimpleAssetLibraryIndex& FSimpleAssetLibraryModule::GetIndex()
+{
+	// The index is created lazily, the Asset Registry isn't available yet when this module starts up
+	if (!Index.IsValid())
+	{
+		Index = MakeUnique<FSimpleAssetLibraryIndex>();
+		Index->Initialize();
+	}
+	return *Index;
+}
+
+FSimpleAssetLibraryLoadSets& FSimpleAssetLibraryModule::GetLoadSets()
+{
+	if (!LoadSets.IsValid())
+	{
+		LoadSets = MakeUnique<FSimpleAssetLibraryLoadSets>();
+	}
+	return *LoadSets;
+}
+
+FSimpleAssetLibraryFavorites& FSimpleAssetLibraryModule::GetFavorites()
+{
+	if (!Favorites.IsValid())
+	{
+		Favorites = MakeUnique<FSimpleAssetLibraryFavorites>();
+	}
+	return *Favorites;
+}
+
+FSimpleAssetLibraryPrefsStore& FSimpleAssetLibraryModule::GetPrefsStore()
+{
+	if (!PrefsStore.IsValid())
+	{
+		PrefsStore = MakeUnique<FSimpleAssetLibraryPrefsStore>(USimpleAssetLibrarySubsystem::GetPrefsFilename());
+	}
+	return *PrefsStore;
+}
+
+FSimpleAssetLibraryUsage& FSimpleAssetLibraryModule::GetUsage()
+{
+	if (!Usage.IsValid())
+	{
+		Usage = MakeUnique<FSimpleAssetLibraryUsage>(FPaths::ProjectSavedDir() / TEXT("SimpleAssetLibrary") / TEXT("LibraryUsage.bin"));
+	}
+	return *Usage;
+}
+
+FSimpleAssetLibraryTypeCatalog& FSimpleAssetLibraryModule::GetTypeCatalog()
+{
+	if (!TypeCatalog.IsValid())
+	{
+		TypeCatalog = MakeUnique<FSimpleAssetLibraryTypeCatalog>();
+	}
+	return *TypeCatalog;
+}
+
+FSimpleAssetLibraryMaterialPool& FSimpleAssetLibraryModule::GetMaterialPool()
+{
+	if (!MaterialPool.IsValid())
+	{
+		MaterialPool = MakeUnique<FSimpleAssetLibraryMaterialPool>();
+	}
+	return *MaterialPool;
+}
+
+void FSimpleAssetLibraryModule::SetSharedPackDirectory(const FString& Directory)
+{
+	if (Index.IsValid() && !FPaths::IsSamePath(Directory, SharedPackDirectory))
+	{
+		UE_LOG(AssetLibrary, Warning, TEXT("The shared library pack changed after the library index was loaded, restart the editor to use %s"), *Directory);
+	}
+	SharedPackDirectory = Directory;
 }
 
 #undef LOCTEXT_NAMESPACE
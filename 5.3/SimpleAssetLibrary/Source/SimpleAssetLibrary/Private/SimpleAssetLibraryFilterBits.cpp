@@ -0,0 +1,140 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SimpleAssetLibraryFilterBits.h"
+#include "SimpleAssetLibraryEntryStore.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "UObject/Class.h"
+
+
+namespace
+{
+    constexpr int32 BitsPerWord = 64;
+
+    void BuildCriterionBits(const TArray<int32>& ValueIds, int32 NumValues, int32 NumWords, TArray<uint64>& OutBits)
+    {
+        OutBits.Reset();
+        OutBits.AddZeroed(NumValues * NumWords);
+        for (int32 Row = 0; Row < ValueIds.Num(); Row++)
+        {
+            OutBits[ValueIds[Row] * NumWords + Row / BitsPerWord] |= uint64(1) << (Row % BitsPerWord);
+        }
+    }
+}
+
+
+void
+FSimpleAssetLibraryFilterBits::Build(const FSimpleAssetLibraryEntryStore& Store)
+{
+    Rows = Store.Num();
+    Words = FMath::DivideAndRoundUp(Rows, BitsPerWord);
+
+    // Classes aren't interned by the store, give them ids here
+    ClassPaths.Reset();
+    ClassIds.Reset();
+    DerivedClassIds.Reset();
+    TArray<int32> ClassIdColumn;
+    ClassIdColumn.Reserve(Rows);
+    for (const FTopLevelAssetPath& ClassPath : Store.GetAssetClassPaths())
+    {
+        int32* ClassId = ClassIds.Find(ClassPath);
+        if (ClassId == nullptr) {
+            ClassId = &ClassIds.Add(ClassPath, ClassPaths.Add(ClassPath));
+        }
+        ClassIdColumn.Add(*ClassId);
+    }
+
+    const FSimpleAssetLibraryNames& Names = Store.GetNames();
+    BuildCriterionBits(Store.GetAssetTypeIds(), Names.AssetTypes.Num(), Words, Bits[static_cast<int32>(ESimpleAssetLibraryFilterCriterion::AssetType)]);
+    BuildCriterionBits(Store.GetCategoryIds(), Names.Categories.Num(), Words, Bits[static_cast<int32>(ESimpleAssetLibraryFilterCriterion::Category)]);
+    BuildCriterionBits(Store.GetAddedByIds(), Names.Authors.Num(), Words, Bits[static_cast<int32>(ESimpleAssetLibraryFilterCriterion::AddedBy)]);
+    BuildCriterionBits(ClassIdColumn, ClassPaths.Num(), Words, Bits[static_cast<int32>(ESimpleAssetLibraryFilterCriterion::UnrealClass)]);
+
+    Revision = Store.GetRevision();
+}
+
+int32
+FSimpleAssetLibraryFilterBits::NumValues(ESimpleAssetLibraryFilterCriterion Criterion) const
+{
+    return Words > 0 ? Bits[static_cast<int32>(Criterion)].Num() / Words : 0;
+}
+
+const uint64*
+FSimpleAssetLibraryFilterBits::GetBits(ESimpleAssetLibraryFilterCriterion Criterion, int32 ValueId) const
+{
+    if (ValueId < 0 || ValueId >= NumValues(Criterion)) {
+        return nullptr;
+    }
+    return Bits[static_cast<int32>(Criterion)].GetData() + ValueId * Words;
+}
+
+void
+FSimpleAssetLibraryFilterBits::FindClassIds(const FString& ClassName, bool bIncludeDerived, TArray<int32, TInlineAllocator<16>>& OutClassIds) const
+{
+    // A class name matches the library classes with that name, the class itself is only needed for its derived classes
+    FTopLevelAssetPath BaseClass;
+    if (ClassName.StartsWith(TEXT("/"))) {
+        BaseClass = FTopLevelAssetPath(ClassName);
+        if (const int32* ClassId = ClassIds.Find(BaseClass)) {
+            OutClassIds.AddUnique(*ClassId);
+        }
+    }
+    else {
+        const FName ShortName(*ClassName);
+        for (int32 ClassId = 0; ClassId < ClassPaths.Num(); ClassId++)
+        {
+            if (ClassPaths[ClassId].GetAssetName() == ShortName) {
+                OutClassIds.AddUnique(ClassId);
+            }
+        }
+        if (bIncludeDerived) {
+            if (const UClass* Class = FindFirstObject<UClass>(*ClassName, EFindFirstObjectOptions::NativeFirst)) {
+                BaseClass = Class->GetClassPathName();
+            }
+        }
+    }
+
+    if (!bIncludeDerived || !BaseClass.IsValid()) {
+        return;
+    }
+
+    // the Asset Registry knows the hierarchy of the native and the Blueprint classes, only ask it once per base class
+    const TArray<int32>* Derived = DerivedClassIds.Find(BaseClass);
+    if (Derived == nullptr) {
+        TSet<FTopLevelAssetPath> DerivedClasses;
+        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+        AssetRegistry.GetDerivedClassNames({ BaseClass }, TSet<FTopLevelAssetPath>(), DerivedClasses);
+        DerivedClasses.Add(BaseClass);
+
+        TArray<int32> DerivedIds;
+        for (int32 ClassId = 0; ClassId < ClassPaths.Num(); ClassId++)
+        {
+            if (DerivedClasses.Contains(ClassPaths[ClassId])) {
+                DerivedIds.Add(ClassId);
+            }
+        }
+        Derived = &DerivedClassIds.Add(BaseClass, MoveTemp(DerivedIds));
+    }
+    for (int32 ClassId : *Derived)
+    {
+        OutClassIds.AddUnique(ClassId);
+    }
+}
+
+uint64
+FSimpleAssetLibraryFilterBits::GetLastWordMask() const
+{
+    const int32 LastBits = Rows % BitsPerWord;
+    return LastBits == 0 ? ~uint64(0) : (uint64(1) << LastBits) - 1;
+}
+
+int32
+FSimpleAssetLibraryFilterBits::CountBits(TConstArrayView<uint64> RowBits)
+{
+    int32 Count = 0;
+    for (const uint64 Word : RowBits)
+    {
+        Count += static_cast<int32>(FMath::CountBits(Word));
+    }
+    return Count;
+}
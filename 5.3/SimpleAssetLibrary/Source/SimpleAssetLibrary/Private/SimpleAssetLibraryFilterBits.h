@@ -0,0 +1,59 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SimpleAssetLibraryFilter.h"
+#include "UObject/TopLevelAssetPath.h"
+
+class FSimpleAssetLibraryEntryStore;
+
+
+/*
+*	One bitset per criterion value, with one bit per store row.
+*
+*	Compound filters are evaluated a 64 rows word at a time: the bitsets of the values of a criterion
+*	are OR'ed and the criteria are AND'ed. Counts are the popcount of the resulting words.
+*	The bitsets of a value id are stored contiguously, GetBits() returns NumWords() words.
+*/
+class FSimpleAssetLibraryFilterBits
+{
+public:
+	/** Rebuild the bitsets from the id columns of the store */
+	void Build(const FSimpleAssetLibraryEntryStore& Store);
+
+	/** the store revision the bitsets were built from */
+	int32 GetRevision() const { return Revision; }
+
+	int32 NumRows() const { return Rows; }
+	int32 NumWords() const { return Words; }
+	int32 NumValues(ESimpleAssetLibraryFilterCriterion Criterion) const;
+
+	/** the bitset of the rows with the given value, nullptr if the value id is unknown */
+	const uint64* GetBits(ESimpleAssetLibraryFilterCriterion Criterion, int32 ValueId) const;
+
+	/**  Get the ids of the library classes matching a filter class
+	 * The class ids are local to the bitsets, the other criteria use the store's name table ids.
+	 * @param  ClassName  a full class path like /Script/Engine.StaticMesh, or a class name like StaticMesh
+	 * @param  bIncludeDerived  whether the classes derived from it match too, the class hierarchy is resolved once per Build()
+	 * @param  OutClassIds  the matching class ids are added to it
+	 */
+	void FindClassIds(const FString& ClassName, bool bIncludeDerived, TArray<int32, TInlineAllocator<16>>& OutClassIds) const;
+	const TArray<FTopLevelAssetPath>& GetClassPaths() const { return ClassPaths; }
+
+	/** the mask of the rows that exist in the last word */
+	uint64 GetLastWordMask() const;
+
+	static int32 CountBits(TConstArrayView<uint64> RowBits);
+
+private:
+	TArray<uint64> Bits[static_cast<int32>(ESimpleAssetLibraryFilterCriterion::Num)];
+	TArray<FTopLevelAssetPath> ClassPaths;
+	TMap<FTopLevelAssetPath, int32> ClassIds;
+
+	/** the library class ids derived from a base class, resolved by the Asset Registry on first use */
+	mutable TMap<FTopLevelAssetPath, TArray<int32>> DerivedClassIds;
+	int32 Rows = 0;
+	int32 Words = 0;
+	int32 Revision = INDEX_NONE;
+};
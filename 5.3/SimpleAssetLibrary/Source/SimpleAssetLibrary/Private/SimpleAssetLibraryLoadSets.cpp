@@ -0,0 +1,167 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SimpleAssetLibraryLoadSets.h"
+#include "SimpleAssetLibrary.h"
+#include "SimpleAssetLibraryBPLibrary.h"
+#include "SimpleAssetLibraryStats.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/PackageName.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+
+
+namespace
+{
+    // Number of prefetched entries kept loaded, older prefetches are released
+    constexpr int32 MaxPrefetches = 8;
+
+    IAssetRegistry& GetAssetRegistry()
+    {
+        return FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    }
+}
+
+
+FSimpleAssetLibraryLoadSets::FSimpleAssetLibraryLoadSets()
+{
+    PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FSimpleAssetLibraryLoadSets::HandlePackageSaved);
+}
+
+FSimpleAssetLibraryLoadSets::~FSimpleAssetLibraryLoadSets()
+{
+    UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+}
+
+FSimpleAssetLibraryLoadSets&
+FSimpleAssetLibraryLoadSets::Get()
+{
+    return FSimpleAssetLibraryModule::Get().GetLoadSets();
+}
+
+const FSimpleAssetLibraryLoadSet&
+FSimpleAssetLibraryLoadSets::GetLoadSet(FName PackageName)
+{
+    if (const FSimpleAssetLibraryLoadSet* LoadSet = LoadSets.Find(PackageName)) {
+        return *LoadSet;
+    }
+    SCOPE_CYCLE_COUNTER(STAT_SimpleAssetLibrary_LoadSet);
+
+    // Walk the hard package dependencies breadth first, the packages array doubles as the queue
+    FSimpleAssetLibraryLoadSet LoadSet;
+    TSet<FName> Visited;
+    LoadSet.Packages.Add(PackageName);
+    Visited.Add(PackageName);
+
+    IAssetRegistry& AssetRegistry = GetAssetRegistry();
+    TArray<FName> Dependencies;
+    for (int32 PackageIndex = 0; PackageIndex < LoadSet.Packages.Num(); PackageIndex++)
+    {
+        const FName Package = LoadSet.Packages[PackageIndex];
+        LoadSet.DiskSize += GetPackageDiskSize(Package);
+
+        Dependencies.Reset();
+        AssetRegistry.GetDependencies(Package, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+        for (const FName Dependency : Dependencies)
+        {
+            // script packages are always loaded
+            bool bAlreadyVisited = false;
+            Visited.Add(Dependency, &bAlreadyVisited);
+            if (!bAlreadyVisited && !FPackageName::IsScriptPackage(Dependency.ToString())) {
+                LoadSet.Packages.Add(Dependency);
+            }
+        }
+    }
+    return LoadSets.Add(PackageName, MoveTemp(LoadSet));
+}
+
+bool
+FSimpleAssetLibraryLoadSets::Prefetch(const FSoftObjectPath& AssetPath)
+{
+    if (AssetPath.IsNull()) {
+        return false;
+    }
+    Prefetches.RemoveAll([&AssetPath](const TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>& Prefetch) { return Prefetch.Key == AssetPath; });
+
+    // the async loader pulls in the whole dependency closure of the asset
+    TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(AssetPath, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+    if (!Handle.IsValid()) {
+        UE_LOG(AssetLibrary, Warning, TEXT("Could not prefetch %s"), *AssetPath.ToString());
+        return false;
+    }
+
+    Prefetches.Emplace(AssetPath, MoveTemp(Handle));
+    if (Prefetches.Num() > MaxPrefetches) {
+        Prefetches[0].Value->ReleaseHandle();
+        Prefetches.RemoveAt(0);
+    }
+    return true;
+}
+
+bool
+FSimpleAssetLibraryLoadSets::IsPrefetched(const FSoftObjectPath& AssetPath) const
+{
+    if (const TSharedPtr<FStreamableHandle>* Pin = Pins.Find(AssetPath)) {
+        return (*Pin)->HasLoadCompleted();
+    }
+    for (const TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>& Prefetch : Prefetches)
+    {
+        if (Prefetch.Key == AssetPath) {
+            return Prefetch.Value->HasLoadCompleted();
+        }
+    }
+    return false;
+}
+
+bool
+FSimpleAssetLibraryLoadSets::Pin(const FSoftObjectPath& AssetPath)
+{
+    if (AssetPath.IsNull()) {
+        return false;
+    }
+    if (Pins.Contains(AssetPath)) {
+        return true;
+    }
+    TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(AssetPath, FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority);
+    if (!Handle.IsValid()) {
+        UE_LOG(AssetLibrary, Warning, TEXT("Could not pin %s"), *AssetPath.ToString());
+        return false;
+    }
+    Pins.Add(AssetPath, MoveTemp(Handle));
+    return true;
+}
+
+void
+FSimpleAssetLibraryLoadSets::Unpin(const FSoftObjectPath& AssetPath)
+{
+    TSharedPtr<FStreamableHandle> Handle;
+    if (Pins.RemoveAndCopyValue(AssetPath, Handle)) {
+        Handle->ReleaseHandle();
+    }
+}
+
+void
+FSimpleAssetLibraryLoadSets::Invalidate()
+{
+    LoadSets.Reset();
+    PackageDiskSizes.Reset();
+}
+
+void
+FSimpleAssetLibraryLoadSets::HandlePackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+    // any saved package may be a dependency of the cached sets
+    Invalidate();
+}
+
+int64
+FSimpleAssetLibraryLoadSets::GetPackageDiskSize(FName PackageName)
+{
+    if (const int64* DiskSize = PackageDiskSizes.Find(PackageName)) {
+        return *DiskSize;
+    }
+    const TOptional<FAssetPackageData> PackageData = GetAssetRegistry().GetAssetPackageDataCopy(PackageName);
+    const int64 DiskSize = PackageData.IsSet() ? FMath::Max<int64>(PackageData->DiskSize, 0) : 0;
+    PackageDiskSizes.Add(PackageName, DiskSize);
+    return DiskSize;
+}
@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SimpleAssetLibraryMaterialPool.h"
+#include "SimpleAssetLibrary.h"
+
+#include "Engine/Texture.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "UObject/Package.h"
+
+
+namespace
+{
+    // Number of returned materials kept for reuse, more than the tiles a library window shows at once
+    constexpr int32 MaxFreeMaterials = 256;
+
+    // The thumbnail parameter of M_asset_thumbnail, the name is only built once
+    const FName ThumbnailTextureParameterName(TEXT("texture"));
+    const FMaterialParameterInfo ThumbnailTextureParameterInfo(ThumbnailTextureParameterName);
+}
+
+
+FSimpleAssetLibraryMaterialPool::FSimpleAssetLibraryMaterialPool()
+{
+}
+
+FSimpleAssetLibraryMaterialPool::~FSimpleAssetLibraryMaterialPool()
+{
+}
+
+FSimpleAssetLibraryMaterialPool&
+FSimpleAssetLibraryMaterialPool::Get()
+{
+    return FSimpleAssetLibraryModule::Get().GetMaterialPool();
+}
+
+UMaterialInstanceDynamic*
+FSimpleAssetLibraryMaterialPool::Acquire(UMaterialInterface* Parent)
+{
+    if (Parent == nullptr) {
+        return nullptr;
+    }
+
+    // reuse the most recently returned material of the same parent
+    for (int32 Index = FreeMaterials.Num() - 1; Index >= 0; Index--)
+    {
+        UMaterialInstanceDynamic* Material = FreeMaterials[Index].Material.Get();
+        if (Material && Material->Parent == Parent) {
+            Borrowed.Add(Material, FreeMaterials[Index].Parameters);
+            FreeMaterials.RemoveAt(Index, 1, false);
+            return Material;
+        }
+    }
+
+    UMaterialInstanceDynamic* Material = UMaterialInstanceDynamic::Create(Parent, GetTransientPackage());
+    if (Material == nullptr) {
+        return nullptr;
+    }
+    FMaterialParameters Parameters;
+    UTexture* DefaultTexture = nullptr;
+    if (Material->GetTextureParameterValue(ThumbnailTextureParameterInfo, DefaultTexture)) {
+        Parameters.DefaultTexture = DefaultTexture;
+        Material->InitializeTextureParameterAndGetIndex(ThumbnailTextureParameterName, Parameters.TextureParameterIndex);
+    }
+    NumCreated++;
+
+    if (Borrowed.Num() >= BorrowedCompactSize) {
+        RemoveStaleBorrowed();
+    }
+    Borrowed.Add(Material, Parameters);
+    return Material;
+}
+
+void
+FSimpleAssetLibraryMaterialPool::Release(UMaterialInstanceDynamic* Material)
+{
+    FMaterialParameters Parameters;
+    if (Material == nullptr || !Borrowed.RemoveAndCopyValue(Material, Parameters)) {
+        return;
+    }
+    if (FreeMaterials.Num() >= MaxFreeMaterials) {
+        NumCreated--;
+        return;
+    }
+
+    // don't keep the last thumbnail alive while the material waits in the pool
+    if (Parameters.TextureParameterIndex != INDEX_NONE) {
+        Material->SetTextureParameterByIndex(Parameters.TextureParameterIndex, Parameters.DefaultTexture.Get());
+    }
+    FFreeMaterial& FreeMaterial = FreeMaterials.AddDefaulted_GetRef();
+    FreeMaterial.Material.Reset(Material);
+    FreeMaterial.Parameters = Parameters;
+}
+
+void
+FSimpleAssetLibraryMaterialPool::SetThumbnailTexture(UMaterialInstanceDynamic* Material, UTexture* Texture)
+{
+    if (Material == nullptr) {
+        return;
+    }
+    const FMaterialParameters* Parameters = Borrowed.Find(Material);
+    if (Parameters && Parameters->TextureParameterIndex != INDEX_NONE && Material->SetTextureParameterByIndex(Parameters->TextureParameterIndex, Texture)) {
+        return;
+    }
+    Material->SetTextureParameterValueByInfo(ThumbnailTextureParameterInfo, Texture);
+}
+
+void
+FSimpleAssetLibraryMaterialPool::Reset()
+{
+    NumCreated -= FreeMaterials.Num();
+    FreeMaterials.Reset();
+}
+
+void
+FSimpleAssetLibraryMaterialPool::RemoveStaleBorrowed()
+{
+    for (auto It = Borrowed.CreateIterator(); It; ++It)
+    {
+        if (It.Key().ResolveObjectPtr() == nullptr) {
+            It.RemoveCurrent();
+            NumCreated--;
+        }
+    }
+    BorrowedCompactSize = FMath::Max(Borrowed.Num() * 2, 256);
+}
@@ -0,0 +1,219 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SimpleAssetLibraryNameSearch.h"
+#include "SimpleAssetLibraryBPLibrary.h"
+#include "SimpleAssetLibraryEntryStore.h"
+
+#include "Algo/Count.h"
+#include "Algo/UpperBound.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#include <emmintrin.h>
+#define SIMPLEASSETLIBRARY_NAME_SEARCH_SSE2 1
+#else
+#define SIMPLEASSETLIBRARY_NAME_SEARCH_SSE2 0
+#endif
+
+
+namespace
+{
+    // Characters loaded per vector by the SSE2 kernel, the blob keeps that much padding at its end
+    constexpr int32 VectorWidth = 8;
+
+    // Append the lowercase UTF-16 form of a string, TCHAR is 4 bytes on some platforms
+    template <typename AllocatorType>
+    void AppendLowerUTF16(const FString& String, TArray<UTF16CHAR, AllocatorType>& Out)
+    {
+        for (const TCHAR Char : String)
+        {
+            const uint32 Lower = static_cast<uint32>(FChar::ToLower(Char));
+            if (Lower <= 0xFFFF) {
+                Out.Add(static_cast<UTF16CHAR>(Lower));
+            }
+            else {
+                const uint32 Offset = Lower - 0x10000;
+                Out.Add(static_cast<UTF16CHAR>(0xD800 + (Offset >> 10)));
+                Out.Add(static_cast<UTF16CHAR>(0xDC00 + (Offset & 0x3FF)));
+            }
+        }
+    }
+
+    bool MatchesAt(const UTF16CHAR* Blob, int32 Position, TConstArrayView<UTF16CHAR> Needle)
+    {
+        return FMemory::Memcmp(Blob + Position, Needle.GetData(), Needle.Num() * sizeof(UTF16CHAR)) == 0;
+    }
+}
+
+
+void
+FSimpleAssetLibraryNameSearch::Build(const FSimpleAssetLibraryEntryStore& Store)
+{
+    Reset();
+    RowStarts.Reserve(Store.Num());
+    for (int32 Row = 0; Row < Store.Num(); Row++)
+    {
+        AddRow(Store.GetDisplayNames()[Row], Store.GetObjectPaths()[Row].GetAssetName());
+    }
+    Revision = Store.GetRevision();
+}
+
+void
+FSimpleAssetLibraryNameSearch::Reset()
+{
+    Blob.Reset();
+    RowStarts.Reset();
+    Blob.AddZeroed(VectorWidth);
+    Revision = INDEX_NONE;
+}
+
+void
+FSimpleAssetLibraryNameSearch::AddRow(const FString& DisplayName, const FString& AssetName)
+{
+    // drop the padding, add the names and then pad again
+    Blob.SetNum(Blob.Num() - VectorWidth);
+    RowStarts.Add(Blob.Num());
+    AppendLowerUTF16(DisplayName, Blob);
+    Blob.Add(0);
+    AppendLowerUTF16(AssetName, Blob);
+    Blob.Add(0);
+    Blob.AddZeroed(VectorWidth);
+}
+
+void
+FSimpleAssetLibraryNameSearch::FindMatches(const FString& Text, TArrayView<bool> OutRowMatches, bool bAllowVectorized) const
+{
+    TArray<UTF16CHAR, TInlineAllocator<64>> Needle;
+    AppendLowerUTF16(Text, Needle);
+    if (Needle.Num() == 0 || RowStarts.Num() == 0) {
+        return;
+    }
+
+    const UTF16CHAR* Data = Blob.GetData();
+    const int32 NumChars = Blob.Num() - VectorWidth;
+    const int32 LastStart = NumChars - Needle.Num();
+    int32 Position = 0;
+
+#if SIMPLEASSETLIBRARY_NAME_SEARCH_SSE2
+    if (bAllowVectorized) {
+        // Compare 8 positions at a time on the first two characters, a 1 character needle matches any next character
+        const __m128i First = _mm_set1_epi16(static_cast<int16>(Needle[0]));
+        const __m128i Second = _mm_set1_epi16(static_cast<int16>(Needle.Num() > 1 ? Needle[1] : 0));
+        const bool bMatchSecond = Needle.Num() > 1;
+
+        for (; Position + VectorWidth <= LastStart + 1; Position += VectorWidth)
+        {
+            const __m128i FirstChars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + Position));
+            __m128i Candidates = _mm_cmpeq_epi16(FirstChars, First);
+            if (bMatchSecond) {
+                // the padding makes the load past the last full vector safe
+                const __m128i SecondChars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + Position + 1));
+                Candidates = _mm_and_si128(Candidates, _mm_cmpeq_epi16(SecondChars, Second));
+            }
+
+            // two mask bits per 16 bit lane
+            uint32 Mask = static_cast<uint32>(_mm_movemask_epi8(Candidates));
+            while (Mask != 0)
+            {
+                const int32 Lane = FMath::CountTrailingZeros(Mask) / 2;
+                Mask &= ~(3u << (Lane * 2));
+                if (MatchesAt(Data, Position + Lane, Needle)) {
+                    FlagRow(Position + Lane, OutRowMatches);
+                }
+            }
+        }
+    }
+#endif
+
+    // Scalar kernel, also finishes the positions left over by the vectorized one
+    for (; Position <= LastStart; Position++)
+    {
+        if (Data[Position] == Needle[0] && MatchesAt(Data, Position, Needle)) {
+            FlagRow(Position, OutRowMatches);
+        }
+    }
+}
+
+void
+FSimpleAssetLibraryNameSearch::FlagRow(int32 Position, TArrayView<bool> OutRowMatches) const
+{
+    const int32 Row = Algo::UpperBound(RowStarts, Position) - 1;
+    OutRowMatches[Row] = true;
+}
+
+
+namespace
+{
+    // Compare the name search kernels with FString::Contains on generated names:
+    //     SimpleAssetLibrary.BenchmarkNameSearch [NumNames=100000] [Text=rock_12]
+    void BenchmarkNameSearch(const TArray<FString>& Args)
+    {
+        const int32 NumNames = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100000;
+        const FString Text = Args.Num() > 1 ? Args[1] : FString(TEXT("rock_12"));
+        if (NumNames <= 0 || Text.IsEmpty()) {
+            return;
+        }
+
+        static const TCHAR* Words[] = { TEXT("Rock"), TEXT("Tree"), TEXT("Crate"), TEXT("Barrel"), TEXT("Wall"), TEXT("Lamp"), TEXT("Fence"), TEXT("Door") };
+        const int32 NumWords = static_cast<int32>(UE_ARRAY_COUNT(Words));
+        FRandomStream Random(1234);
+        TArray<FString> DisplayNames;
+        TArray<FString> AssetNames;
+        DisplayNames.Reserve(NumNames);
+        AssetNames.Reserve(NumNames);
+        for (int32 Index = 0; Index < NumNames; Index++)
+        {
+            const TCHAR* Word = Words[Random.RandHelper(NumWords)];
+            DisplayNames.Add(FString::Printf(TEXT("%s %s %d"), Word, Words[Random.RandHelper(NumWords)], Index));
+            AssetNames.Add(FString::Printf(TEXT("SM_%s_%05d"), Word, Random.RandHelper(100000)));
+        }
+
+        double StartTime = FPlatformTime::Seconds();
+        FSimpleAssetLibraryNameSearch Search;
+        Search.Reset();
+        for (int32 Index = 0; Index < NumNames; Index++)
+        {
+            Search.AddRow(DisplayNames[Index], AssetNames[Index]);
+        }
+        const double BuildTime = FPlatformTime::Seconds() - StartTime;
+
+        TArray<bool> Matches;
+        auto TimeKernel = [&](bool bAllowVectorized, int32& OutNumMatches)
+        {
+            Matches.Init(false, NumNames);
+            const double KernelStart = FPlatformTime::Seconds();
+            Search.FindMatches(Text, Matches, bAllowVectorized);
+            const double KernelTime = FPlatformTime::Seconds() - KernelStart;
+            OutNumMatches = Algo::Count(Matches, true);
+            return KernelTime;
+        };
+
+        int32 NumVectorMatches = 0;
+        int32 NumScalarMatches = 0;
+        const double VectorTime = TimeKernel(true, NumVectorMatches);
+        const double ScalarTime = TimeKernel(false, NumScalarMatches);
+
+        StartTime = FPlatformTime::Seconds();
+        int32 NumContainsMatches = 0;
+        for (int32 Index = 0; Index < NumNames; Index++)
+        {
+            if (DisplayNames[Index].Contains(Text, ESearchCase::IgnoreCase) || AssetNames[Index].Contains(Text, ESearchCase::IgnoreCase)) {
+                NumContainsMatches++;
+            }
+        }
+        const double ContainsTime = FPlatformTime::Seconds() - StartTime;
+
+        UE_LOG(AssetLibrary, Display, TEXT("Name search on %d names for '%s' (blob built in %.2f ms):"), NumNames, *Text, BuildTime * 1000.0);
+        UE_LOG(AssetLibrary, Display, TEXT("    SSE2 kernel:      %.3f ms, %d matches%s"), VectorTime * 1000.0, NumVectorMatches,
+            SIMPLEASSETLIBRARY_NAME_SEARCH_SSE2 ? TEXT("") : TEXT(" (not available, scalar kernel used)"));
+        UE_LOG(AssetLibrary, Display, TEXT("    scalar kernel:    %.3f ms, %d matches"), ScalarTime * 1000.0, NumScalarMatches);
+        UE_LOG(AssetLibrary, Display, TEXT("    FString::Contains: %.3f ms, %d matches"), ContainsTime * 1000.0, NumContainsMatches);
+    }
+
+    FAutoConsoleCommand BenchmarkNameSearchCommand(
+        TEXT("SimpleAssetLibrary.BenchmarkNameSearch"),
+        TEXT("Compare the Asset Library name search kernels with FString::Contains. Args: [NumNames=100000] [Text=rock_12]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkNameSearch)
+    );
+}
@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FSimpleAssetLibraryEntryStore;
+
+
+/*
+*	Case-insensitive substring search over the display and asset names of the library entries.
+*
+*	The names of every row are lowercased once into a single UTF-16 blob, each name followed by a
+*	null so matches never span two names. A search scans the whole blob with an SSE2 kernel that
+*	compares 8 characters at a time against the first two characters of the text, and only verifies
+*	the candidates. Platforms without SSE2 use the scalar kernel, which finds the same matches.
+*/
+class FSimpleAssetLibraryNameSearch
+{
+public:
+	/** Rebuild the blob from the names of the store rows */
+	void Build(const FSimpleAssetLibraryEntryStore& Store);
+
+	/** Empty the blob, then AddRow() each row in order */
+	void Reset();
+	void AddRow(const FString& DisplayName, const FString& AssetName);
+
+	/** the store revision the blob was built from */
+	int32 GetRevision() const { return Revision; }
+
+	/**  Flag the rows with a name containing the given text, case-insensitive
+	 * @param  Text  the text to search for, must not be empty
+	 * @param  OutRowMatches  one flag per row, matching rows are set to true and the others are left untouched
+	 * @param  bAllowVectorized  whether the SSE2 kernel may be used, false always runs the scalar kernel
+	 */
+	void FindMatches(const FString& Text, TArrayView<bool> OutRowMatches, bool bAllowVectorized = true) const;
+
+	int32 Num() const { return RowStarts.Num(); }
+
+private:
+	void FlagRow(int32 Position, TArrayView<bool> OutRowMatches) const;
+
+	/** the lowercase names, padded with nulls so the kernel can always load a full vector */
+	TArray<UTF16CHAR> Blob;
+
+	/** the position in Blob of the first name of each row */
+	TArray<int32> RowStarts;
+
+	int32 Revision = INDEX_NONE;
+};
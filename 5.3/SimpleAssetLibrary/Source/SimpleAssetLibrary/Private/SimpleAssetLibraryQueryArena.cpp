@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SimpleAssetLibraryQueryArena.h"
+#include "SimpleAssetLibraryStats.h"
+
+
+FSimpleAssetLibraryQueryArena::FSimpleAssetLibraryQueryArena(int64 InitialSize)
+{
+    AddBlock(InitialSize);
+}
+
+FSimpleAssetLibraryQueryArena::~FSimpleAssetLibraryQueryArena()
+{
+    DEC_MEMORY_STAT_BY(STAT_SimpleAssetLibrary_ArenaMemory, Capacity);
+}
+
+void
+FSimpleAssetLibraryQueryArena::Reset()
+{
+    // Merge the blocks of a query that outgrew the arena, the next queries then fit in a single block
+    if (Blocks.Num() > 1) {
+        const int64 MergedSize = Capacity;
+        DEC_MEMORY_STAT_BY(STAT_SimpleAssetLibrary_ArenaMemory, Capacity);
+        Blocks.Reset();
+        Capacity = 0;
+        AddBlock(MergedSize);
+    }
+    CurrentBlock = 0;
+    CurrentOffset = 0;
+}
+
+void*
+FSimpleAssetLibraryQueryArena::AllocateBytes(int64 Size, int64 Alignment)
+{
+    INC_DWORD_STAT(STAT_SimpleAssetLibrary_ArenaAllocations);
+
+    // Try the current block, then the next one, adding a block large enough for the allocation if needed
+    while (true)
+    {
+        TArray64<uint8>& Block = Blocks[CurrentBlock];
+        uint8* Data = Align(Block.GetData() + CurrentOffset, Alignment);
+        if (Data + Size <= Block.GetData() + Block.Num()) {
+            CurrentOffset = (Data + Size) - Block.GetData();
+            return Data;
+        }
+
+        if (CurrentBlock + 1 >= Blocks.Num()) {
+            AddBlock(FMath::Max(Size + Alignment, Blocks.Last().Num() * 2));
+        }
+        CurrentBlock++;
+        CurrentOffset = 0;
+    }
+}
+
+void
+FSimpleAssetLibraryQueryArena::AddBlock(int64 Size)
+{
+    INC_DWORD_STAT(STAT_SimpleAssetLibrary_ArenaHeapAllocations);
+    INC_MEMORY_STAT_BY(STAT_SimpleAssetLibrary_ArenaMemory, Size);
+
+    TArray64<uint8>& Block = Blocks.AddDefaulted_GetRef();
+    Block.SetNumUninitialized(Size);
+    Capacity += Size;
+}
@@ -0,0 +1,361 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SimpleAssetLibraryThumbnailCache.h"
+#include "SimpleAssetLibraryBPLibrary.h"
+#include "SimpleAssetLibraryIndex.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "Engine/Texture2D.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/xxhash.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "ImageUtils.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "ObjectTools.h"
+#include "RHI.h"
+#include "RenderingThread.h"
+#include "TextureResource.h"
+#include "UObject/Package.h"
+
+
+namespace
+{
+    // The thumbnail textures shown by the tiles, by package name
+    TMap<FName, TWeakObjectPtr<UTexture2D>> SharedThumbnailTextures;
+
+    // The same textures by hash of their compressed image, identical thumbnails share one texture
+    TMap<uint64, TWeakObjectPtr<UTexture2D>> SharedThumbnailTexturesByImage;
+
+    // Stale textures are dropped when the map doubled since the last time
+    int32 SharedThumbnailTexturesCompactSize = 256;
+
+    uint64 HashImage(TConstArrayView<uint8> Image)
+    {
+        return FXxHash64::HashBuffer(Image.GetData(), Image.Num()).Hash;
+    }
+
+    template <typename KeyType>
+    void RemoveStaleTextures(TMap<KeyType, TWeakObjectPtr<UTexture2D>>& Textures)
+    {
+        for (auto It = Textures.CreateIterator(); It; ++It)
+        {
+            if (!It.Value().IsValid()) {
+                It.RemoveCurrent();
+            }
+        }
+    }
+
+    // the compressed thumbnail image of a library entry, from the index cache or else from its package
+    bool LoadLibraryThumbnailImage(const FAssetData& AssetData, TArray<uint8>& OutImage, int32& OutWidth, int32& OutHeight)
+    {
+        FSimpleAssetLibraryIndex& Index = FSimpleAssetLibraryIndex::Get();
+        if (Index.LoadCachedThumbnail(AssetData.PackageName, OutImage, OutWidth, OutHeight)) {
+            return true;
+        }
+
+        TArray64<uint8> CompressedImage;
+        if (!SimpleAssetLibraryThumbnails::LoadCompressedPackageThumbnail(AssetData, CompressedImage, OutWidth, OutHeight)) {
+            return false;
+        }
+        OutImage = TArray<uint8>(CompressedImage.GetData(), static_cast<int32>(CompressedImage.Num()));
+        Index.CacheThumbnail(AssetData.PackageName, OutImage, OutWidth, OutHeight);
+        return true;
+    }
+}
+
+FSimpleAssetLibraryThumbnailCache::FSimpleAssetLibraryThumbnailCache(const FString& InFilename)
+: Filename(InFilename)
+{}
+
+FSimpleAssetLibraryThumbnailCache::~FSimpleAssetLibraryThumbnailCache()
+{
+    CloseHandles();
+}
+
+bool
+FSimpleAssetLibraryThumbnailCache::Read(int64 Offset, int32 Size, TArray<uint8>& OutData) const
+{
+    if (Offset < 0 || Size <= 0) {
+        return false;
+    }
+
+    if (!ReadHandle) {
+        // allow writing so the write handle can keep appending while we read
+        ReadHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*Filename, true));
+        if (!ReadHandle) {
+            return false;
+        }
+    }
+
+    if (Offset + Size > ReadHandle->Size() || !ReadHandle->Seek(Offset)) {
+        return false;
+    }
+
+    OutData.SetNumUninitialized(Size);
+    if (!ReadHandle->Read(OutData.GetData(), Size)) {
+        OutData.Reset();
+        return false;
+    }
+    return true;
+}
+
+int64
+FSimpleAssetLibraryThumbnailCache::Append(TConstArrayView<uint8> Data)
+{
+    if (Data.Num() == 0) {
+        return INDEX_NONE;
+    }
+
+    if (!WriteHandle) {
+        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+        PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Filename));
+        WriteHandle.Reset(PlatformFile.OpenWrite(*Filename, true, true));
+        if (!WriteHandle) {
+            UE_LOG(AssetLibrary, Warning, TEXT("Failed to open the Asset Library thumbnail cache: %s"), *Filename);
+            return INDEX_NONE;
+        }
+    }
+
+    // many entries have byte-identical thumbnails, store them once
+    const uint64 Hash = HashImage(Data);
+    if (const TPair<int64, int32>* Image = ImagesByHash.Find(Hash)) {
+        if (Image->Value == Data.Num()) {
+            NumSharedImages++;
+            return Image->Key;
+        }
+    }
+
+    const int64 Offset = WriteHandle->Tell();
+    if (!WriteHandle->Write(Data.GetData(), Data.Num()) || !WriteHandle->Flush()) {
+        UE_LOG(AssetLibrary, Warning, TEXT("Failed to write to the Asset Library thumbnail cache: %s"), *Filename);
+        return INDEX_NONE;
+    }
+    ImagesByHash.Add(Hash, TPair<int64, int32>(Offset, Data.Num()));
+    return Offset;
+}
+
+int64
+FSimpleAssetLibraryThumbnailCache::GetSize() const
+{
+    return FMath::Max<int64>(FPlatformFileManager::Get().GetPlatformFile().FileSize(*Filename), 0);
+}
+
+bool
+FSimpleAssetLibraryThumbnailCache::Compact(TConstArrayView<TPair<int64, int32>> LiveImages, TArray<int64>& OutOffsets)
+{
+    OutOffsets.Reset(LiveImages.Num());
+    WriteHandle.Reset();
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    const FString TempFilename = Filename + TEXT(".tmp");
+    TUniquePtr<IFileHandle> TempHandle(PlatformFile.OpenWrite(*TempFilename));
+    if (!TempHandle) {
+        UE_LOG(AssetLibrary, Warning, TEXT("Failed to compact the Asset Library thumbnail cache: %s"), *Filename);
+        return false;
+    }
+
+    // the images are copied one at a time, the blob is never read whole
+    TMap<int64, int64> NewOffsets;
+    TArray<uint8> Image;
+    bool bWritten = true;
+    for (const TPair<int64, int32>& LiveImage : LiveImages)
+    {
+        if (const int64* NewOffset = NewOffsets.Find(LiveImage.Key)) {
+            OutOffsets.Add(*NewOffset);
+            continue;
+        }
+        const int64 NewOffset = TempHandle->Tell();
+        if (!Read(LiveImage.Key, LiveImage.Value, Image) || !TempHandle->Write(Image.GetData(), Image.Num())) {
+            bWritten = false;
+            break;
+        }
+        NewOffsets.Add(LiveImage.Key, NewOffset);
+        OutOffsets.Add(NewOffset);
+    }
+    bWritten = bWritten && TempHandle->Flush();
+    TempHandle.Reset();
+
+    CloseHandles();
+    if (!bWritten || !IFileManager::Get().Move(*Filename, *TempFilename, true, true)) {
+        UE_LOG(AssetLibrary, Warning, TEXT("Failed to compact the Asset Library thumbnail cache: %s"), *Filename);
+        PlatformFile.DeleteFile(*TempFilename);
+        OutOffsets.Reset();
+        return false;
+    }
+
+    // the images appended this session moved too, the dropped ones can't be shared anymore
+    for (auto It = ImagesByHash.CreateIterator(); It; ++It)
+    {
+        if (const int64* NewOffset = NewOffsets.Find(It.Value().Key)) {
+            It.Value().Key = *NewOffset;
+        }
+        else {
+            It.RemoveCurrent();
+        }
+    }
+    return true;
+}
+
+void
+FSimpleAssetLibraryThumbnailCache::Reset()
+{
+    CloseHandles();
+    ImagesByHash.Reset();
+    NumSharedImages = 0;
+    FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*Filename);
+}
+
+void
+FSimpleAssetLibraryThumbnailCache::CloseHandles()
+{
+    ReadHandle.Reset();
+    WriteHandle.Reset();
+}
+
+
+namespace SimpleAssetLibraryThumbnails
+{
+    bool LoadCompressedPackageThumbnail(const FAssetData& AssetData, TArray64<uint8>& OutCompressedImage, int32& OutWidth, int32& OutHeight)
+    {
+        /* thanks to 3dRaven on this method
+         * https://forums.unrealengine.com/t/getting-asset-thumbnails-as-a-texture2d/1180079/2
+         */
+        FString PackageFilename;
+        if (AssetData.PackageName.IsNone() || !FPackageName::DoesPackageExist(AssetData.PackageName.ToString(), &PackageFilename)) {
+            return false;
+        }
+
+        const FName ObjectFullName = FName(*AssetData.GetFullName());
+        TSet<FName> ObjectFullNames;
+        ObjectFullNames.Add(ObjectFullName);
+
+        FThumbnailMap ThumbnailMap;
+        ThumbnailTools::LoadThumbnailsFromPackage(PackageFilename, ObjectFullNames, ThumbnailMap);
+        const FObjectThumbnail* Thumbnail = ThumbnailMap.Find(ObjectFullName);
+        if (!Thumbnail || Thumbnail->IsEmpty()) {
+            return false;
+        }
+
+        IImageWrapperModule& ImageWrapperModule = FModuleManager::Get().LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+        TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+
+        OutWidth = Thumbnail->GetImageWidth();
+        OutHeight = Thumbnail->GetImageHeight();
+
+        const TArray<uint8>& ImageData = Thumbnail->GetUncompressedImageData();
+        ImageWrapper->SetRaw(ImageData.GetData(), ImageData.Num(), OutWidth, OutHeight, ERGBFormat::BGRA, 8);
+
+        OutCompressedImage = ImageWrapper->GetCompressed();
+        return OutCompressedImage.Num() > 0;
+    }
+
+    UTexture2D* CreateThumbnailTexture(TArray<uint8>&& Pixels, int32 Width, int32 Height)
+    {
+        if (Width < 1 || Height < 1 || Pixels.Num() != Width * Height * static_cast<int32>(sizeof(FColor))) {
+            return nullptr;
+        }
+
+        // The mip has no bulk data, the resource is created empty and the pixels only exist in the upload command.
+        // UpdateResource mustn't be called again, it would recreate the resource from the empty mip
+        UTexture2D* Texture = NewObject<UTexture2D>(GetTransientPackage(), NAME_None, RF_Transient);
+        FTexturePlatformData* PlatformData = new FTexturePlatformData();
+        PlatformData->SizeX = Width;
+        PlatformData->SizeY = Height;
+        PlatformData->PixelFormat = PF_B8G8R8A8;
+        PlatformData->Mips.Add(new FTexture2DMipMap(Width, Height, 1));
+        Texture->SetPlatformData(PlatformData);
+        Texture->NeverStream = true;
+        Texture->bNotOfflineProcessed = true;
+        Texture->UpdateResource();
+
+        // the resource is released through the render thread too, it outlives the command even if the texture is collected
+        FTextureResource* Resource = Texture->GetResource();
+        ENQUEUE_RENDER_COMMAND(SimpleAssetLibraryUploadThumbnail)(
+            [Resource, Pixels = MoveTemp(Pixels), Width, Height](FRHICommandListImmediate& RHICmdList)
+            {
+                FRHITexture2D* RHITexture = Resource ? Resource->GetTexture2DRHI() : nullptr;
+                if (RHITexture) {
+                    const FUpdateTextureRegion2D Region(0, 0, 0, 0, Width, Height);
+                    RHIUpdateTexture2D(RHITexture, 0, Region, Width * sizeof(FColor), Pixels.GetData());
+                }
+            }
+        );
+        return Texture;
+    }
+
+    UTexture2D* LoadLibraryThumbnailTexture(const FAssetData& AssetData, int32& OutWidth, int32& OutHeight)
+    {
+        // Library entries keep their compressed thumbnail in the index's thumbnail cache
+        TArray<uint8> Image;
+        if (!LoadLibraryThumbnailImage(AssetData, Image, OutWidth, OutHeight)) {
+            return nullptr;
+        }
+        return FImageUtils::ImportBufferAsTexture2D(Image);
+    }
+
+    UTexture2D* GetSharedLibraryThumbnailTexture(const FAssetData& AssetData)
+    {
+        if (const TWeakObjectPtr<UTexture2D>* SharedTexture = SharedThumbnailTextures.Find(AssetData.PackageName)) {
+            if (UTexture2D* Texture = SharedTexture->Get()) {
+                return Texture;
+            }
+        }
+
+        int32 Width = 0;
+        int32 Height = 0;
+        TArray<uint8> Image;
+        if (!LoadLibraryThumbnailImage(AssetData, Image, Width, Height)) {
+            return nullptr;
+        }
+
+        // another entry may show the same image already, the texture is only created once
+        const uint64 ImageHash = HashImage(Image);
+        UTexture2D* Texture = SharedThumbnailTexturesByImage.FindRef(ImageHash).Get();
+        if (Texture == nullptr) {
+            Texture = FImageUtils::ImportBufferAsTexture2D(Image);
+            if (Texture == nullptr) {
+                return nullptr;
+            }
+            SharedThumbnailTexturesByImage.Add(ImageHash, Texture);
+        }
+
+        if (SharedThumbnailTextures.Num() >= SharedThumbnailTexturesCompactSize) {
+            RemoveStaleTextures(SharedThumbnailTextures);
+            RemoveStaleTextures(SharedThumbnailTexturesByImage);
+            SharedThumbnailTexturesCompactSize = FMath::Max(SharedThumbnailTextures.Num() * 2, 256);
+        }
+        SharedThumbnailTextures.Add(AssetData.PackageName, Texture);
+        return Texture;
+    }
+
+    void GetSharedLibraryThumbnailTextureCounts(int32& OutNumEntries, int32& OutNumTextures)
+    {
+        OutNumEntries = 0;
+        TSet<const UTexture2D*> Textures;
+        for (const TPair<FName, TWeakObjectPtr<UTexture2D>>& Pair : SharedThumbnailTextures)
+        {
+            if (const UTexture2D* Texture = Pair.Value.Get()) {
+                Textures.Add(Texture);
+                OutNumEntries++;
+            }
+        }
+        OutNumTextures = Textures.Num();
+    }
+
+    void RenameSharedLibraryThumbnailTexture(FName OldPackageName, FName NewPackageName)
+    {
+        TWeakObjectPtr<UTexture2D> Texture;
+        if (SharedThumbnailTextures.RemoveAndCopyValue(OldPackageName, Texture) && Texture.IsValid()) {
+            SharedThumbnailTextures.Add(NewPackageName, Texture);
+        }
+    }
+
+    void ForgetSharedLibraryThumbnailTexture(FName PackageName)
+    {
+        SharedThumbnailTextures.Remove(PackageName);
+    }
+}
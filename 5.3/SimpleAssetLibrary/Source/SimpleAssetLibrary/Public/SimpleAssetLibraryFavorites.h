@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/StrongObjectPtr.h"
+
+class UTexture2D;
+
+
+/*
+*	The recently placed and the favorite library entries of the user.
+*
+*	Both lists are saved with the user settings of the Asset Library. Their entries are pinned: they are
+*	loaded in the background with their dependencies and their thumbnails are kept, so placing a
+*	recent or favorite entry again needs neither a query nor a load.
+*	Entries are identified by package name, the ones not in the library yet are pinned when the
+*	library index adds them.
+*/
+class SIMPLEASSETLIBRARY_API FSimpleAssetLibraryFavorites
+{
+public:
+	FSimpleAssetLibraryFavorites();
+	~FSimpleAssetLibraryFavorites();
+
+	/** Get the recent and favorite entries owned by the SimpleAssetLibrary module */
+	static FSimpleAssetLibraryFavorites& Get();
+
+	/** the recently placed entries, the most recent first */
+	const TArray<FName>& GetRecent() const { return Recent; }
+
+	/** the favorite entries, in the order they were added */
+	const TArray<FName>& GetFavorites() const { return Favorites; }
+
+	bool IsFavorite(FName PackageName) const { return Favorites.Contains(PackageName); }
+
+	/**  Move an entry to the front of the recent entries, the oldest entry is dropped when the list is full
+	 * @param  PackageName  the long package name of the placed entry
+	 */
+	void AddRecent(FName PackageName);
+
+	/**  Add or remove a favorite entry
+	 * @param  PackageName  the long package name of the entry
+	 * @param  bFavorite  whether the entry is a favorite
+	 */
+	void SetFavorite(FName PackageName, bool bFavorite);
+
+	void ClearRecent();
+
+private:
+	/** Pin the entries of both lists and unpin the entries no longer in either */
+	void UpdatePins();
+
+	void HandleEntriesChanged();
+
+	struct FPinnedEntry
+	{
+		FSoftObjectPath AssetPath;
+
+		/** nullptr for the entries without a thumbnail */
+		TStrongObjectPtr<UTexture2D> Thumbnail;
+	};
+
+	TArray<FName> Recent;
+	TArray<FName> Favorites;
+	TMap<FName, FPinnedEntry> Pinned;
+
+	FDelegateHandle EntriesChangedHandle;
+};
@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/StrongObjectPtr.h"
+
+class UMaterialInstanceDynamic;
+class UMaterialInterface;
+class UTexture;
+
+
+/*
+*	Pool of the dynamic thumbnail materials of the library entry widgets.
+*
+*	The entries a window gets from USimpleAssetLibrarySubsystem::GetGuiEntries borrow a material each, the
+*	window returns them when it gets its entries again or closes, so changing the asset type or reopening
+*	the library reuses the same materials instead of creating one per entry widget.
+*	The index of the "texture" parameter is looked up once when a material is created, setting the
+*	thumbnail of a pooled material doesn't search its parameters by name.
+*/
+class SIMPLEASSETLIBRARY_API FSimpleAssetLibraryMaterialPool
+{
+public:
+	FSimpleAssetLibraryMaterialPool();
+	~FSimpleAssetLibraryMaterialPool();
+
+	/** Get the material pool owned by the SimpleAssetLibrary module */
+	static FSimpleAssetLibraryMaterialPool& Get();
+
+	/**  Borrow a dynamic material of the given parent, a returned one is reused if there is one
+	 * @param  Parent  the thumbnail material, like M_asset_thumbnail
+	 * @return  the material, nullptr if the parent is null
+	 */
+	UMaterialInstanceDynamic* Acquire(UMaterialInterface* Parent);
+
+	/**  Return a borrowed material to the pool, its texture is reset to the parent's
+	 * materials that weren't borrowed from the pool are ignored
+	 */
+	void Release(UMaterialInstanceDynamic* Material);
+
+	/**  Set the thumbnail texture of a material, through the cached parameter index if it's pooled
+	 * @param  Material  a pooled material or any material instance with a "texture" parameter
+	 */
+	void SetThumbnailTexture(UMaterialInstanceDynamic* Material, UTexture* Texture);
+
+	/** the number of materials created and the number of them lent out, including the ones lost with their widget until they're collected */
+	int32 GetNumMaterials() const { return NumCreated; }
+	int32 GetNumBorrowed() const { return Borrowed.Num(); }
+
+	/** Drop the returned materials, the borrowed ones are left to their widgets */
+	void Reset();
+
+private:
+	struct FMaterialParameters
+	{
+		/** the index of the "texture" parameter, INDEX_NONE if the parent has none */
+		int32 TextureParameterIndex = INDEX_NONE;
+
+		/** the texture of the parent, set back when the material is returned */
+		TWeakObjectPtr<UTexture> DefaultTexture;
+	};
+
+	struct FFreeMaterial
+	{
+		TStrongObjectPtr<UMaterialInstanceDynamic> Material;
+		FMaterialParameters Parameters;
+	};
+
+	/** Forget the lent materials that were garbage collected with their widget */
+	void RemoveStaleBorrowed();
+
+	/** the materials returned to the pool, the most recently returned last */
+	TArray<FFreeMaterial> FreeMaterials;
+
+	/** the lent materials, weakly keyed, a widget destroyed without returning its material just loses it */
+	TMap<TObjectKey<UMaterialInstanceDynamic>, FMaterialParameters> Borrowed;
+
+	/** stale lent materials are dropped when the map doubled since the last time */
+	int32 BorrowedCompactSize = 256;
+
+	int32 NumCreated = 0;
+};
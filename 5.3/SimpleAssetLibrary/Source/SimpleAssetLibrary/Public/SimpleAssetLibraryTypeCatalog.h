@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/*
+*	The asset types of the Asset Library: the ones declared in the config and the ones the library entries use.
+*
+*	The types in use are counted from the asset type column of the library index, again whenever the
+*	index entries change. Types used by entries but missing from the config, and config types no entry
+*	uses, are reported so the config can be fixed.
+*	The color of a type is computed once: the config types are spread over the color wheel in config
+*	order, the other types get a hue from their name so they keep their color between sessions.
+*/
+class SIMPLEASSETLIBRARY_API FSimpleAssetLibraryTypeCatalog
+{
+public:
+	FSimpleAssetLibraryTypeCatalog();
+	~FSimpleAssetLibraryTypeCatalog();
+
+	/** Get the type catalog owned by the SimpleAssetLibrary module */
+	static FSimpleAssetLibraryTypeCatalog& Get();
+
+	/**  Set the asset types declared in the config, the colors are computed again if they changed
+	 * @param  Types  the asset types, in config order
+	 */
+	void SetConfigTypes(TConstArrayView<FString> Types);
+	const TArray<FName>& GetConfigTypes() const { return ConfigTypes; }
+
+	/** the asset types used by at least one library entry, sorted by name */
+	TArray<FName> GetUsedTypes();
+
+	/** the number of library entries of an asset type */
+	int32 GetNumEntries(FName AssetType);
+
+	/** the asset types used by library entries that the config doesn't declare, sorted by name */
+	TArray<FName> GetUndeclaredTypes();
+
+	/** the asset types declared in the config that no library entry uses, in config order */
+	TArray<FName> GetUnusedTypes();
+
+	/** the color of an asset type, computed on first use */
+	FLinearColor GetColor(FName AssetType);
+
+	/** changes whenever the config types or the types in use change */
+	int32 GetRevision() const { return Revision; }
+
+private:
+	/** Count the types of the library index entries if they changed since the last count, the first count starts listening to the index */
+	void BuildIfNeeded();
+
+	/** Count the entries of every type from the asset type ids of the index store */
+	void CountEntries();
+
+	void HandleEntriesChanged();
+
+	/** Log the types in use missing from the config, once per type */
+	void ReportUndeclaredType(FName AssetType);
+
+	FLinearColor ComputeColor(FName AssetType) const;
+
+	TArray<FName> ConfigTypes;
+
+	TMap<FName, int32> EntryCounts;
+
+	/** the revision of the index store the entries were counted at */
+	int32 CountedStoreRevision = INDEX_NONE;
+
+	TMap<FName, FLinearColor> Colors;
+	TSet<FName> ReportedTypes;
+
+	int32 Revision = 0;
+	bool bBuilt = false;
+
+	FDelegateHandle EntriesChangedHandle;
+};
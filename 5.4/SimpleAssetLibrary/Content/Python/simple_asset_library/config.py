@@ -1,59 +1,19 @@
-
-import json
-from pathlib import Path
 import typing
-import unreal
-
-
-BASE_CONFIG = {
-  "asset_types": [
-    "char",
-    "envir",
-    "FX",
-    "prop"
-  ],
-  "default_category_options": [
-    "default"
-  ],
-  "placed_actor_folder": "placed"
-}
 
-
-def get_plugin_directory() -> Path:
-    """Get the root directory for this plugin as a Path object
-
-    Returns:
-        (Path) the plugin's root directory
-    """
-    return Path(unreal.PluginBlueprintLibrary.get_plugin_base_dir("SimpleAssetLibrary")).resolve()
+from simple_asset_library.unreal_systems import SimpleAssetLibrarySubsystem
 
 
-def get_config_data() -> typing.Dict[str, str]:
-    """Get the config settings for this plugin
+def reload_config():
+    """Read the config settings again, e.g. after editing the settings json
 
-    1) if available, get the settings for the current uproject:
+    The settings are read by the SimpleAssetLibrarySubsystem from:
+    1) if available, the settings for the current uproject:
         <project_dir>/Config/simple_asset_library_settings.json
-    2) otherwise, use the default settings from the uplugin:
+    2) otherwise, the default settings from the uplugin:
         <plugin_dir>/Config/simple_asset_library_settings.json
-    3) lastly, use the BASE_CONFIG in the python module
-        if the default settings file is missing
-
-    Returns:
-        (dict) a dictionary of the config data
+    3) lastly, the built-in defaults if the default settings file is missing
     """
-
-    # Check if the settings json is set in the project
-    settings_json = Path(unreal.Paths.project_config_dir()) / "simple_asset_library_settings.json"
-    if settings_json.exists():
-        return json.loads(settings_json.read_text())
-
-    # Check for the default settings json in the plugin's directory
-    settings_json = get_plugin_directory() / "Config/simple_asset_library_settings.json"
-    if settings_json.exists():
-        return json.loads(settings_json.read_text())
-
-    # Otherwise, return the base config defined in this module
-    return BASE_CONFIG
+    SimpleAssetLibrarySubsystem.reload_config()
 
 
 def get_config_asset_types() -> typing.List[str]:
@@ -62,8 +22,7 @@ def get_config_asset_types() -> typing.List[str]:
     Returns:
         (list(str)) the list of asset types
     """
-    settings = get_config_data()
-    return settings.get("asset_types", ["default"])
+    return [str(asset_type) for asset_type in SimpleAssetLibrarySubsystem.get_available_asset_types(False)]
 
 
 def get_config_default_categories() -> typing.List[str]:
@@ -75,15 +34,33 @@ def get_config_default_categories() -> typing.List[str]:
     Returns:
         (list(str)) the list of default categories
     """
-    settings = get_config_data()
-    return settings.get("default_category_options", ["default"])
+    return [str(category) for category in SimpleAssetLibrarySubsystem.get_default_categories()]
 
 
-def get_config_actor_folder_path() -> typing.List[str]:
+def get_config_actor_folder_path() -> str:
     """Get the actor folder path setting defined in the settings json
 
     Returns:
         (str) the default actor folder path to assign actors placed from the Asset Library UI
     """
-    settings = get_config_data()
-    return settings.get("placed_actor_folder", "")
+    return str(SimpleAssetLibrarySubsystem.get_placed_actor_folder())
+
+
+def get_config_shared_library_pack() -> str:
+    """Get the shared library pack folder defined in the settings json
+
+    Returns:
+        (str) the absolute path of the shared library pack folder, or an empty string if disabled
+    """
+    return str(SimpleAssetLibrarySubsystem.get_shared_library_pack_directory())
+
+
+def get_config_library_scan_roots() -> typing.List[str]:
+    """Get the content roots defined in the settings json whose package headers are read from disk
+
+    Note: they are only read when the Asset Library opens before the Asset Registry finished discovering assets
+
+    Returns:
+        (list(str)) the long package paths of the content roots, like /Game/
+    """
+    return [str(root) for root in SimpleAssetLibrarySubsystem.get_library_scan_roots()]
@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SimpleAssetLibraryBPLibrary.h"
+#include "UObject/StrongObjectPtr.h"
+#include "Widgets/SCompoundWidget.h"
+
+class SBox;
+class UTexture2D;
+
+
+/*
+*	A single tile of the library tile view: the entry thumbnail above its display name.
+*	Tiles are pooled by the tile view, SetEntry() points a recycled tile at another entry.
+*/
+class SSimpleAssetLibraryTile : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SSimpleAssetLibraryTile)
+	{}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	/**  Show the given entry in this tile
+	 * @param  Entry  the library data of the entry
+	 * @param  DefaultThumbnail  the texture to show if the entry has no thumbnail
+	 */
+	void SetEntry(const FSimpleAssetLibraryEntryInfo& Entry, UTexture2D* DefaultThumbnail);
+
+	/** Release the entry's thumbnail, called when the tile is returned to the pool */
+	void ClearEntry();
+
+	void SetTileSize(const FVector2D& Size);
+
+private:
+	/** the display name and the load set of the entry, only resolved when the tooltip is shown */
+	FText GetEntryToolTipText() const;
+
+	TSharedPtr<SBox> SizeBox;
+	FSlateBrush ThumbnailBrush;
+	FText DisplayName;
+	FName PackageName;
+
+	/** the thumbnail texture is kept alive by the tiles showing the entry, in every window */
+	TStrongObjectPtr<UTexture2D> ThumbnailTexture;
+};
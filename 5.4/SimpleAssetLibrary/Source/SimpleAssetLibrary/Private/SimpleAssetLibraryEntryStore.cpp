@@ -0,0 +1,536 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SimpleAssetLibraryEntryStore.h"
+
+#include "HAL/PlatformFileManager.h"
+#include "Hash/xxhash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+
+
+namespace SimpleAssetLibraryTags
+{
+    const FName ManagedAsset(TEXT("ALIB_managed_asset"));
+    const FName AssetType(TEXT("ALIB_asset_type"));
+    const FName AssetCategory(TEXT("ALIB_asset_category"));
+    const FName DisplayName(TEXT("ALIB_display_name"));
+    const FName AddedBy(TEXT("ALIB_added_by"));
+
+    const FName All(TEXT("all"));
+}
+
+namespace
+{
+    // Get a metadata value the same way metadata.get_asset_metadata does, "None" counts as unset
+    FString GetLibraryTag(const FAssetData& AssetData, FName Tag, const TCHAR* Default)
+    {
+        FString Value;
+        if (!AssetData.GetTagValue(Tag, Value) || Value.IsEmpty() || Value == TEXT("None")) {
+            return FString(Default);
+        }
+        return Value;
+    }
+
+    // Intern a metadata value, FNames compare case-insensitively so 'Props' and 'props' share an id
+    int32 InternLibraryTag(FSimpleAssetLibraryNameTable& Table, const FAssetData& AssetData, FName Tag, const TCHAR* Default)
+    {
+        return Table.Intern(FName(*GetLibraryTag(AssetData, Tag, Default)));
+    }
+
+    // Move the given rows of a column into a new column, in the given order
+    template <typename ElementType>
+    void ReorderColumn(TArray<ElementType>& Column, const TArray<int32>& Rows)
+    {
+        TArray<ElementType> Reordered;
+        Reordered.Reserve(Rows.Num());
+        for (int32 Row : Rows)
+        {
+            Reordered.Add(MoveTemp(Column[Row]));
+        }
+        Column = MoveTemp(Reordered);
+    }
+
+    // Columns are serialized without their own count, the row count is validated once for all of them
+    template <typename ElementType>
+    void SerializeColumn(FArchive& Ar, TArray<ElementType>& Column, int32 NumRows)
+    {
+        if (Ar.IsLoading()) {
+            Column.SetNum(NumRows);
+        }
+        for (ElementType& Element : Column)
+        {
+            Ar << Element;
+        }
+    }
+
+    // paths are stored as plain strings, the manifest doesn't need redirector or linker fixups
+    template <typename PathType>
+    void SerializePathColumn(FArchive& Ar, TArray<PathType>& Column, int32 NumRows)
+    {
+        TArray<FString> Paths;
+        if (Ar.IsSaving()) {
+            Paths.Reserve(NumRows);
+            for (const PathType& Path : Column)
+            {
+                Paths.Add(Path.ToString());
+            }
+        }
+        SerializeColumn(Ar, Paths, NumRows);
+        if (Ar.IsLoading()) {
+            Column.Reset(NumRows);
+            for (const FString& Path : Paths)
+            {
+                Column.Add(PathType(Path));
+            }
+        }
+    }
+
+    bool IsValidColumnIds(const TArray<int32>& Ids, const FSimpleAssetLibraryNameTable& Table)
+    {
+        for (int32 Id : Ids)
+        {
+            if (!Table.GetNames().IsValidIndex(Id)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool GetPackageFilename(FName PackageName, FString& OutFilename)
+    {
+        return FPackageName::TryConvertLongPackageNameToFilename(PackageName.ToString(), OutFilename, FPackageName::GetAssetPackageExtension());
+    }
+
+    // the file is mapped rather than read into a buffer, only changed packages are ever hashed
+    uint64 HashPackageFile(const FString& Filename)
+    {
+        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+        TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*Filename));
+        TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile ? MappedFile->MapRegion() : nullptr);
+        if (MappedRegion) {
+            return FXxHash64::HashBuffer(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize()).Hash;
+        }
+        TArray64<uint8> Data;
+        if (!FFileHelper::LoadFileToArray(Data, *Filename, FILEREAD_Silent)) {
+            return 0;
+        }
+        return FXxHash64::HashBuffer(Data.GetData(), Data.Num()).Hash;
+    }
+
+    // Serial and revision numbers are unique across every store so a handle or cache can never match a replaced store
+    int32 AllocateSerial()
+    {
+        static int32 NextSerial = 0;
+        return ++NextSerial;
+    }
+}
+
+
+FSimpleAssetLibraryNameTable::FSimpleAssetLibraryNameTable()
+{
+    Reset();
+}
+
+int32
+FSimpleAssetLibraryNameTable::Intern(FName Name)
+{
+    if (const int32* Id = Ids.Find(Name)) {
+        return *Id;
+    }
+    const int32 NewId = Names.Add(Name);
+    Ids.Add(Name, NewId);
+    return NewId;
+}
+
+int32
+FSimpleAssetLibraryNameTable::Find(FName Name) const
+{
+    const int32* Id = Ids.Find(Name);
+    return Id ? *Id : INDEX_NONE;
+}
+
+void
+FSimpleAssetLibraryNameTable::Reset()
+{
+    Names.Reset();
+    Ids.Reset();
+    Intern(NAME_None);
+}
+
+FArchive&
+operator<<(FArchive& Ar, FSimpleAssetLibraryNameTable& Table)
+{
+    Ar << Table.Names;
+    if (Ar.IsLoading()) {
+        Table.Ids.Reset();
+        Table.Ids.Reserve(Table.Names.Num());
+        for (int32 Id = 0; Id < Table.Names.Num(); Id++)
+        {
+            Table.Ids.Add(Table.Names[Id], Id);
+        }
+        // a corrupted table must still reserve id 0 for None
+        if (Table.Names.Num() == 0 || !Table.Names[0].IsNone()) {
+            Ar.SetError();
+        }
+    }
+    return Ar;
+}
+
+void
+FSimpleAssetLibraryNames::Reset()
+{
+    AssetTypes.Reset();
+    Categories.Reset();
+    Authors.Reset();
+}
+
+FArchive&
+operator<<(FArchive& Ar, FSimpleAssetLibraryNames& Names)
+{
+    return Ar << Names.AssetTypes << Names.Categories << Names.Authors;
+}
+
+FArchive&
+operator<<(FArchive& Ar, FSimpleAssetLibraryThumbnailRef& Ref)
+{
+    return Ar << Ref.Offset << Ref.Size << Ref.Width << Ref.Height;
+}
+
+
+FSimpleAssetLibraryPackageFingerprint
+FSimpleAssetLibraryPackageFingerprint::FromPackage(FName PackageName, bool bHash)
+{
+    FSimpleAssetLibraryPackageFingerprint Fingerprint;
+    FString Filename;
+    if (!GetPackageFilename(PackageName, Filename)) {
+        return Fingerprint;
+    }
+    const FFileStatData StatData = FPlatformFileManager::Get().GetPlatformFile().GetStatData(*Filename);
+    if (!StatData.bIsValid || StatData.bIsDirectory) {
+        return Fingerprint;
+    }
+    Fingerprint.Size = StatData.FileSize;
+    Fingerprint.Timestamp = StatData.ModificationTime.GetTicks();
+    Fingerprint.Hash = bHash ? HashPackageFile(Filename) : 0;
+    return Fingerprint;
+}
+
+bool
+FSimpleAssetLibraryPackageFingerprint::MatchesPackage(FName PackageName, FSimpleAssetLibraryPackageFingerprint& OutCurrent) const
+{
+    OutCurrent = FromPackage(PackageName, false);
+    if (!IsSet() || !OutCurrent.IsSet()) {
+        return false;
+    }
+    if (OutCurrent.Size == Size && OutCurrent.Timestamp == Timestamp) {
+        OutCurrent.Hash = Hash;
+        return true;
+    }
+    // a fingerprint recorded without a hash can't tell an unchanged file from a changed one of the same size
+    if (OutCurrent.Size != Size || Hash == 0) {
+        return false;
+    }
+
+    // the hash is kept for the next time, the file is only read when only its timestamp changed
+    FString Filename;
+    GetPackageFilename(PackageName, Filename);
+    OutCurrent.Hash = HashPackageFile(Filename);
+    return OutCurrent.Hash == Hash;
+}
+
+FArchive&
+operator<<(FArchive& Ar, FSimpleAssetLibraryPackageFingerprint& Fingerprint)
+{
+    return Ar << Fingerprint.Size << Fingerprint.Timestamp << Fingerprint.Hash;
+}
+
+
+bool
+FSimpleAssetLibraryEntry::FromAssetData(const FAssetData& AssetData, FSimpleAssetLibraryNames& Names, FSimpleAssetLibraryEntry& OutEntry)
+{
+    if (!AssetData.IsValid() || AssetData.PackagePath.ToString().StartsWith(TEXT("/Temp/"))) {
+        return false;
+    }
+
+    FString ManagedValue;
+    if (!AssetData.GetTagValue(SimpleAssetLibraryTags::ManagedAsset, ManagedValue) || !ManagedValue.Equals(TEXT("true"), ESearchCase::IgnoreCase)) {
+        return false;
+    }
+
+    OutEntry.PackageName = AssetData.PackageName;
+    OutEntry.ObjectPath = AssetData.GetSoftObjectPath();
+    OutEntry.AssetClassPath = AssetData.AssetClassPath;
+    OutEntry.DisplayName = GetLibraryTag(AssetData, SimpleAssetLibraryTags::DisplayName, TEXT(""));
+    OutEntry.AssetTypeId = InternLibraryTag(Names.AssetTypes, AssetData, SimpleAssetLibraryTags::AssetType, TEXT(""));
+    OutEntry.CategoryId = InternLibraryTag(Names.Categories, AssetData, SimpleAssetLibraryTags::AssetCategory, TEXT("default"));
+    OutEntry.AddedById = InternLibraryTag(Names.Authors, AssetData, SimpleAssetLibraryTags::AddedBy, TEXT("unknown"));
+
+    // Same order as metadata.find_assets: local assets before plugin assets, then display name, then full name
+    const bool bIsLocal = AssetData.PackagePath.ToString().StartsWith(TEXT("/Game/"));
+    OutEntry.SortKey = FString::Printf(TEXT("%c%c%s%c%s"),
+        bIsLocal ? TEXT('0') : TEXT('1'), TCHAR(1),
+        *OutEntry.DisplayName.ToLower(), TCHAR(1),
+        *AssetData.GetFullName().ToLower()
+    );
+
+    OutEntry.Thumbnail = FSimpleAssetLibraryThumbnailRef();
+    OutEntry.Flags = ESimpleAssetLibraryEntryFlags::None;
+    return true;
+}
+
+bool
+FSimpleAssetLibraryEntry::HasSameLibraryData(const FSimpleAssetLibraryEntry& Other) const
+{
+    return PackageName == Other.PackageName
+        && ObjectPath == Other.ObjectPath
+        && AssetClassPath == Other.AssetClassPath
+        && DisplayName.Equals(Other.DisplayName)
+        && AssetTypeId == Other.AssetTypeId
+        && CategoryId == Other.CategoryId
+        && AddedById == Other.AddedById
+        && SortKey.Equals(Other.SortKey);
+}
+
+void
+FSimpleAssetLibraryEntry::CopyThumbnailFrom(const FSimpleAssetLibraryEntry& Other)
+{
+    Thumbnail = Other.Thumbnail;
+    Flags = (Flags & ~ESimpleAssetLibraryEntryFlags::SharedThumbnail) | (Other.Flags & ESimpleAssetLibraryEntryFlags::SharedThumbnail);
+}
+
+
+FSimpleAssetLibraryEntryStore::FSimpleAssetLibraryEntryStore()
+: Serial(AllocateSerial())
+, Revision(AllocateSerial())
+{}
+
+int32
+FSimpleAssetLibraryEntryStore::Find(FName PackageName) const
+{
+    const int32* Row = RowByPackage.Find(PackageName);
+    return Row ? *Row : INDEX_NONE;
+}
+
+FSimpleAssetLibraryEntry
+FSimpleAssetLibraryEntryStore::GetEntry(int32 Row) const
+{
+    FSimpleAssetLibraryEntry Entry;
+    Entry.PackageName = PackageNames[Row];
+    Entry.ObjectPath = ObjectPaths[Row];
+    Entry.AssetClassPath = AssetClassPaths[Row];
+    Entry.DisplayName = DisplayNames[Row];
+    Entry.AssetTypeId = AssetTypeIds[Row];
+    Entry.CategoryId = CategoryIds[Row];
+    Entry.AddedById = AddedByIds[Row];
+    Entry.SortKey = SortKeys[Row];
+    Entry.Thumbnail = Thumbnails[Row];
+    Entry.Flags = Flags[Row];
+    Entry.Fingerprint = Fingerprints[Row];
+    return Entry;
+}
+
+void
+FSimpleAssetLibraryEntryStore::Add(FSimpleAssetLibraryEntry&& Entry)
+{
+    RowByPackage.Add(Entry.PackageName, PackageNames.Num());
+
+    PackageNames.Add(Entry.PackageName);
+    ObjectPaths.Add(MoveTemp(Entry.ObjectPath));
+    AssetClassPaths.Add(Entry.AssetClassPath);
+    DisplayNames.Add(MoveTemp(Entry.DisplayName));
+    SortKeys.Add(MoveTemp(Entry.SortKey));
+    AssetTypeIds.Add(Entry.AssetTypeId);
+    CategoryIds.Add(Entry.CategoryId);
+    AddedByIds.Add(Entry.AddedById);
+    Thumbnails.Add(Entry.Thumbnail);
+    Flags.Add(Entry.Flags);
+    Fingerprints.Add(Entry.Fingerprint);
+    Revision = AllocateSerial();
+}
+
+void
+FSimpleAssetLibraryEntryStore::Set(int32 Row, FSimpleAssetLibraryEntry&& Entry)
+{
+    if (PackageNames[Row] != Entry.PackageName) {
+        RowByPackage.Remove(PackageNames[Row]);
+        RowByPackage.Add(Entry.PackageName, Row);
+    }
+
+    PackageNames[Row] = Entry.PackageName;
+    ObjectPaths[Row] = MoveTemp(Entry.ObjectPath);
+    AssetClassPaths[Row] = Entry.AssetClassPath;
+    DisplayNames[Row] = MoveTemp(Entry.DisplayName);
+    SortKeys[Row] = MoveTemp(Entry.SortKey);
+    AssetTypeIds[Row] = Entry.AssetTypeId;
+    CategoryIds[Row] = Entry.CategoryId;
+    AddedByIds[Row] = Entry.AddedById;
+    Thumbnails[Row] = Entry.Thumbnail;
+    Flags[Row] = Entry.Flags;
+    Fingerprints[Row] = Entry.Fingerprint;
+    Revision = AllocateSerial();
+}
+
+void
+FSimpleAssetLibraryEntryStore::Remove(const TBitArray<>& RowsToRemove)
+{
+    TArray<int32> KeptRows;
+    KeptRows.Reserve(Num());
+    for (int32 Row = 0; Row < Num(); Row++)
+    {
+        if (!RowsToRemove.IsValidIndex(Row) || !RowsToRemove[Row]) {
+            KeptRows.Add(Row);
+        }
+    }
+    if (KeptRows.Num() != Num()) {
+        Reorder(KeptRows);
+    }
+}
+
+void
+FSimpleAssetLibraryEntryStore::RemoveAt(int32 Row)
+{
+    TBitArray<> RowsToRemove(false, Num());
+    RowsToRemove[Row] = true;
+    Remove(RowsToRemove);
+}
+
+void
+FSimpleAssetLibraryEntryStore::SetThumbnail(int32 Row, const FSimpleAssetLibraryThumbnailRef& Thumbnail, bool bShared)
+{
+    Thumbnails[Row] = Thumbnail;
+    if (bShared) {
+        EnumAddFlags(Flags[Row], ESimpleAssetLibraryEntryFlags::SharedThumbnail);
+    }
+    else {
+        EnumRemoveFlags(Flags[Row], ESimpleAssetLibraryEntryFlags::SharedThumbnail);
+    }
+}
+
+void
+FSimpleAssetLibraryEntryStore::Sort()
+{
+    // sort a permutation rather than the rows, only the sort key column is read
+    TArray<int32> SortedRows;
+    SortedRows.SetNumUninitialized(Num());
+    for (int32 Row = 0; Row < Num(); Row++)
+    {
+        SortedRows[Row] = Row;
+    }
+    SortedRows.Sort([this](int32 A, int32 B)
+    {
+        return SortKeys[A].Compare(SortKeys[B], ESearchCase::CaseSensitive) < 0;
+    });
+
+    for (int32 Row = 0; Row < Num(); Row++)
+    {
+        if (SortedRows[Row] != Row) {
+            Reorder(SortedRows);
+            return;
+        }
+    }
+}
+
+void
+FSimpleAssetLibraryEntryStore::Reset()
+{
+    Names.Reset();
+    PackageNames.Reset();
+    ObjectPaths.Reset();
+    AssetClassPaths.Reset();
+    DisplayNames.Reset();
+    SortKeys.Reset();
+    AssetTypeIds.Reset();
+    CategoryIds.Reset();
+    AddedByIds.Reset();
+    Thumbnails.Reset();
+    Flags.Reset();
+    Fingerprints.Reset();
+    RowByPackage.Reset();
+    Serial = AllocateSerial();
+    Revision = AllocateSerial();
+}
+
+void
+FSimpleAssetLibraryEntryStore::Reorder(const TArray<int32>& Rows)
+{
+    ReorderColumn(PackageNames, Rows);
+    ReorderColumn(ObjectPaths, Rows);
+    ReorderColumn(AssetClassPaths, Rows);
+    ReorderColumn(DisplayNames, Rows);
+    ReorderColumn(SortKeys, Rows);
+    ReorderColumn(AssetTypeIds, Rows);
+    ReorderColumn(CategoryIds, Rows);
+    ReorderColumn(AddedByIds, Rows);
+    ReorderColumn(Thumbnails, Rows);
+    ReorderColumn(Flags, Rows);
+    ReorderColumn(Fingerprints, Rows);
+
+    RebuildLookup();
+    Serial = AllocateSerial();
+    Revision = AllocateSerial();
+}
+
+void
+FSimpleAssetLibraryEntryStore::RebuildLookup()
+{
+    RowByPackage.Reset();
+    RowByPackage.Reserve(Num());
+    for (int32 Row = 0; Row < Num(); Row++)
+    {
+        RowByPackage.Add(PackageNames[Row], Row);
+    }
+}
+
+FArchive&
+operator<<(FArchive& Ar, FSimpleAssetLibraryEntryStore& Store)
+{
+    int32 NumRows = Store.Num();
+    Ar << Store.Names << NumRows;
+
+    // every row takes at least a few bytes, this catches corrupted counts before allocating
+    if (Ar.IsError() || NumRows < 0 || (Ar.IsLoading() && NumRows > Ar.TotalSize())) {
+        Ar.SetError();
+        return Ar;
+    }
+
+    SerializeColumn(Ar, Store.PackageNames, NumRows);
+    SerializePathColumn(Ar, Store.ObjectPaths, NumRows);
+    SerializePathColumn(Ar, Store.AssetClassPaths, NumRows);
+    SerializeColumn(Ar, Store.DisplayNames, NumRows);
+    SerializeColumn(Ar, Store.SortKeys, NumRows);
+    SerializeColumn(Ar, Store.AssetTypeIds, NumRows);
+    SerializeColumn(Ar, Store.CategoryIds, NumRows);
+    SerializeColumn(Ar, Store.AddedByIds, NumRows);
+    SerializeColumn(Ar, Store.Thumbnails, NumRows);
+    SerializeColumn(Ar, Store.Fingerprints, NumRows);
+
+    TArray<uint8> FlagBits;
+    if (Ar.IsSaving()) {
+        FlagBits.Reserve(NumRows);
+        for (ESimpleAssetLibraryEntryFlags EntryFlags : Store.Flags)
+        {
+            FlagBits.Add(static_cast<uint8>(EntryFlags));
+        }
+    }
+    SerializeColumn(Ar, FlagBits, NumRows);
+
+    if (Ar.IsLoading()) {
+        Store.Flags.Reset(NumRows);
+        for (uint8 Bits : FlagBits)
+        {
+            Store.Flags.Add(static_cast<ESimpleAssetLibraryEntryFlags>(Bits));
+        }
+
+        // rows must only refer to values in the name tables
+        if (!IsValidColumnIds(Store.AssetTypeIds, Store.Names.AssetTypes)
+            || !IsValidColumnIds(Store.CategoryIds, Store.Names.Categories)
+            || !IsValidColumnIds(Store.AddedByIds, Store.Names.Authors)) {
+            Ar.SetError();
+        }
+
+        Store.RebuildLookup();
+        Store.Serial = AllocateSerial();
+        Store.Revision = AllocateSerial();
+    }
+    return Ar;
+}
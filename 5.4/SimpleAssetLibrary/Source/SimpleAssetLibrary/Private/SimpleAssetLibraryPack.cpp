@@ -0,0 +1,114 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SimpleAssetLibraryPack.h"
+#include "SimpleAssetLibraryBPLibrary.h"
+#include "SimpleAssetLibraryManifest.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+
+FSimpleAssetLibraryPack::FSimpleAssetLibraryPack()
+{}
+
+FSimpleAssetLibraryPack::~FSimpleAssetLibraryPack()
+{
+    // the region must be released before its file handle
+    MappedThumbnailsRegion.Reset();
+    MappedThumbnails.Reset();
+}
+
+bool
+FSimpleAssetLibraryPack::Mount(const FString& InDirectory)
+{
+    Directory = InDirectory;
+    if (!SimpleAssetLibraryManifest::Load(GetManifestFilename(Directory), Store, PackId) || !PackId.IsValid()) {
+        Store.Reset();
+        return false;
+    }
+
+    // a pack without any thumbnails is still usable, a pack missing the blob of its manifest isn't
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    const FString ThumbnailsFilename = GetThumbnailsFilename(Directory, PackId);
+    if (!PlatformFile.FileExists(*ThumbnailsFilename)) {
+        if (Store.GetThumbnails().ContainsByPredicate([](const FSimpleAssetLibraryThumbnailRef& Thumbnail) { return Thumbnail.IsSet(); })) {
+            UE_LOG(AssetLibrary, Warning, TEXT("The shared library pack %s is missing the thumbnails of its manifest (%s), it isn't mounted"), *Directory, *ThumbnailsFilename);
+            Store.Reset();
+            PackId.Invalidate();
+            return false;
+        }
+    }
+    else {
+        MappedThumbnails.Reset(PlatformFile.OpenMapped(*ThumbnailsFilename));
+        if (MappedThumbnails) {
+            MappedThumbnailsRegion.Reset(MappedThumbnails->MapRegion());
+        }
+        if (!MappedThumbnailsRegion) {
+            UE_LOG(AssetLibrary, Warning, TEXT("Failed to map the shared library thumbnails: %s"), *ThumbnailsFilename);
+        }
+    }
+
+    UE_LOG(AssetLibrary, Log, TEXT("Mounted the shared library pack %s (%d entries)"), *Directory, Store.Num());
+    return true;
+}
+
+bool
+FSimpleAssetLibraryPack::ReadThumbnail(int64 Offset, int32 Size, TArray<uint8>& OutData) const
+{
+    if (!MappedThumbnailsRegion || Offset < 0 || Size <= 0 || Offset + Size > MappedThumbnailsRegion->GetMappedSize()) {
+        return false;
+    }
+    OutData.SetNumUninitialized(Size);
+    FMemory::Memcpy(OutData.GetData(), MappedThumbnailsRegion->GetMappedPtr() + Offset, Size);
+    return true;
+}
+
+bool
+FSimpleAssetLibraryPack::Write(const FString& InDirectory, FSimpleAssetLibraryEntryStore& InStore, TConstArrayView<uint8> ThumbnailBlob, FGuid& OutPackId)
+{
+    IFileManager& FileManager = IFileManager::Get();
+    FileManager.MakeDirectory(*InDirectory, true);
+
+    // Write the thumbnails first under the new pack id, the current manifest keeps pointing into its own blob
+    const FGuid NewPackId = FGuid::NewGuid();
+    const FString ThumbnailsFilename = GetThumbnailsFilename(InDirectory, NewPackId);
+    const FString TempThumbnailsFilename = ThumbnailsFilename + TEXT(".tmp");
+    if (!FFileHelper::SaveArrayToFile(ThumbnailBlob, *TempThumbnailsFilename)
+        || !FileManager.Move(*ThumbnailsFilename, *TempThumbnailsFilename, true, true)) {
+        UE_LOG(AssetLibrary, Warning, TEXT("Failed to write the shared library thumbnails: %s"), *ThumbnailsFilename);
+        FileManager.Delete(*TempThumbnailsFilename);
+        return false;
+    }
+    if (!SimpleAssetLibraryManifest::Save(GetManifestFilename(InDirectory), InStore, NewPackId)) {
+        FileManager.Delete(*ThumbnailsFilename);
+        return false;
+    }
+    OutPackId = NewPackId;
+
+    // the blobs of the previous exports aren't referenced by any manifest anymore
+    TArray<FString> BlobFilenames;
+    FileManager.FindFiles(BlobFilenames, *(InDirectory / TEXT("LibraryThumbnails*.bin")), true, false);
+    for (const FString& BlobFilename : BlobFilenames)
+    {
+        const FString BlobPath = InDirectory / BlobFilename;
+        if (!FPaths::IsSamePath(BlobPath, ThumbnailsFilename)) {
+            FileManager.Delete(*BlobPath, false, false, true);
+        }
+    }
+    return true;
+}
+
+FString
+FSimpleAssetLibraryPack::GetManifestFilename(const FString& InDirectory)
+{
+    return InDirectory / TEXT("LibraryManifest.bin");
+}
+
+FString
+FSimpleAssetLibraryPack::GetThumbnailsFilename(const FString& InDirectory, const FGuid& InPackId)
+{
+    return InDirectory / FString::Printf(TEXT("LibraryThumbnails_%s.bin"), *InPackId.ToString(EGuidFormats::Digits));
+}
@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SimpleAssetLibraryPackageScanner.h"
+#include "SimpleAssetLibraryBPLibrary.h"
+#include "SimpleAssetLibraryEntryStore.h"
+#include "SimpleAssetLibraryStats.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/PackageName.h"
+#include "Serialization/LargeMemoryReader.h"
+#include "UObject/PackageFileSummary.h"
+
+
+namespace
+{
+    bool ReadPackage(FArchive& Ar, const FString& PackageName, TArray<FAssetData>& OutAssets)
+    {
+        FPackageFileSummary Summary;
+        Ar << Summary;
+        if (Ar.IsError() || Summary.Tag != PACKAGE_FILE_TAG || Summary.AssetRegistryDataOffset <= 0 || Summary.AssetRegistryDataOffset >= Ar.TotalSize()) {
+            return false;
+        }
+        // cooked packages are stripped of their editor-only tags
+        if ((Summary.GetPackageFlags() & PKG_FilterEditorOnly) != 0) {
+            return false;
+        }
+
+        // the asset registry data is read with the versions the package was saved with
+        Ar.SetUEVer(Summary.GetFileVersionUE());
+        Ar.SetLicenseeUEVer(Summary.GetFileVersionLicenseeUE());
+        Ar.SetEngineVer(Summary.SavedByEngineVersion);
+        Ar.SetCustomVersions(Summary.GetCustomVersionContainer());
+        Ar.Seek(Summary.AssetRegistryDataOffset);
+
+        int64 DependencyDataOffset = INDEX_NONE;
+        TArray<FAssetData*> AssetDataList;
+        UE::AssetRegistry::EReadPackageDataMainErrorCode ErrorCode;
+        const bool bRead = UE::AssetRegistry::ReadPackageDataMain(Ar, PackageName, Summary, DependencyDataOffset, AssetDataList, ErrorCode);
+        for (FAssetData* AssetData : AssetDataList)
+        {
+            if (bRead) {
+                OutAssets.Add(MoveTemp(*AssetData));
+            }
+            delete AssetData;
+        }
+        return bRead && !Ar.IsError();
+    }
+
+    bool IsManagedAsset(const FAssetData& AssetData)
+    {
+        FString ManagedValue;
+        return AssetData.GetTagValue(SimpleAssetLibraryTags::ManagedAsset, ManagedValue) && ManagedValue.Equals(TEXT("true"), ESearchCase::IgnoreCase);
+    }
+}
+
+
+namespace SimpleAssetLibraryPackageScanner
+{
+    int32 ScanRoots(TConstArrayView<FString> Roots, TArray<FAssetData>& OutAssets)
+    {
+        SCOPE_CYCLE_COUNTER(STAT_SimpleAssetLibrary_ScanPackages);
+        const double StartTime = FPlatformTime::Seconds();
+
+        // the package names are resolved up front, the mount points aren't read from the workers
+        TArray<FString> Filenames;
+        TArray<FString> PackageNames;
+        for (const FString& Root : Roots)
+        {
+            FString RootDirectory;
+            if (!FPackageName::TryConvertLongPackageNameToFilename(Root, RootDirectory)) {
+                UE_LOG(AssetLibrary, Warning, TEXT("Skipping the library scan root %s, it isn't a mounted content root"), *Root);
+                continue;
+            }
+            TArray<FString> RootFilenames;
+            IFileManager::Get().FindFilesRecursive(RootFilenames, *RootDirectory, TEXT("*.uasset"), true, false);
+            for (FString& Filename : RootFilenames)
+            {
+                FString PackageName;
+                if (FPackageName::TryConvertFilenameToLongPackageName(Filename, PackageName)) {
+                    Filenames.Add(MoveTemp(Filename));
+                    PackageNames.Add(MoveTemp(PackageName));
+                }
+            }
+        }
+
+        TArray<TArray<FAssetData>> PackageAssets;
+        PackageAssets.SetNum(Filenames.Num());
+        ParallelFor(Filenames.Num(), [&](int32 Index)
+        {
+            TArray<FAssetData> Assets;
+            if (ScanPackage(Filenames[Index], PackageNames[Index], Assets)) {
+                for (FAssetData& AssetData : Assets)
+                {
+                    if (IsManagedAsset(AssetData)) {
+                        PackageAssets[Index].Add(MoveTemp(AssetData));
+                    }
+                }
+            }
+        });
+
+        const int32 NumAssetsBefore = OutAssets.Num();
+        for (TArray<FAssetData>& Assets : PackageAssets)
+        {
+            OutAssets.Append(MoveTemp(Assets));
+        }
+        UE_LOG(AssetLibrary, Log, TEXT("Scanned %d package headers for Asset Library tags: %d library assets (%.2f ms)"),
+            Filenames.Num(), OutAssets.Num() - NumAssetsBefore, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+        return Filenames.Num();
+    }
+
+    bool ScanPackage(const FString& PackageFilename, const FString& PackageName, TArray<FAssetData>& OutAssets)
+    {
+        // Map the package, only the pages of the summary and the asset registry data are read
+        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+        TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*PackageFilename));
+        TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile ? MappedFile->MapRegion() : nullptr);
+        if (MappedRegion) {
+            FLargeMemoryReader Reader(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize(), ELargeMemoryReaderFlags::None, FName(*PackageFilename));
+            return ReadPackage(Reader, PackageName, OutAssets);
+        }
+
+        // Some platform file layers can't map files, fall back to a regular reader
+        TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*PackageFilename, FILEREAD_Silent));
+        return Reader && ReadPackage(*Reader, PackageName, OutAssets);
+    }
+}
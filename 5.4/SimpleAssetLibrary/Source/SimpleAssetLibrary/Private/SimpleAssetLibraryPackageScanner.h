@@ -0,0 +1,33 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+
+/*
+*	Reads the library tags of the packages on disk without the Asset Registry.
+*
+*	Only the package summary and the asset registry data section of each .uasset are read, the rest
+*	of the file is never touched. The files are memory-mapped and read in parallel, so the library can
+*	show its entries long before the Asset Registry finished discovering a fresh workspace.
+*	Cooked packages carry no editor tags and are skipped.
+*/
+namespace SimpleAssetLibraryPackageScanner
+{
+	/**  Find the managed assets of the packages under the given content roots
+	 * @param  Roots  the long package paths of the content roots, like /Game/
+	 * @param  OutAssets  the assets tagged as managed by the Asset Library, with their tags
+	 * @return  the number of package files read
+	 */
+	int32 ScanRoots(TConstArrayView<FString> Roots, TArray<FAssetData>& OutAssets);
+
+	/**  Read the assets of a single package file
+	 * @param  PackageFilename  the .uasset file
+	 * @param  PackageName  the long package name of the file
+	 * @param  OutAssets  every asset of the package with its tags, appended
+	 * @return  false if the file couldn't be read or holds no asset registry data
+	 */
+	bool ScanPackage(const FString& PackageFilename, const FString& PackageName, TArray<FAssetData>& OutAssets);
+}
@@ -0,0 +1,925 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SimpleAssetLibrarySubsystem.h"
+#include "SimpleAssetLibrary.h"
+#include "SimpleAssetLibraryBPLibrary.h"
+#include "SimpleAssetLibraryFavorites.h"
+#include "SimpleAssetLibraryIndex.h"
+#include "SimpleAssetLibraryMaterialPool.h"
+#include "SimpleAssetLibraryPrefsStore.h"
+#include "SimpleAssetLibraryQueryArena.h"
+#include "SimpleAssetLibraryTypeCatalog.h"
+#include "SimpleAssetLibraryUsage.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Dom/JsonObject.h"
+#include "Editor.h"
+#include "EditorUtilitySubsystem.h"
+#include "EditorUtilityWidget.h"
+#include "EditorUtilityWidgetBlueprint.h"
+#include "Framework/Docking/TabManager.h"
+#include "GameFramework/Actor.h"
+#include "Interfaces/IPluginManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Subsystems/EditorActorSubsystem.h"
+#include "Subsystems/EditorAssetSubsystem.h"
+#include "Subsystems/UnrealEditorSubsystem.h"
+#include "UObject/Package.h"
+#include "Widgets/Docking/SDockTab.h"
+
+
+namespace
+{
+    // The widget blueprint of the Asset Library window
+    const TCHAR* LibraryPanelBlueprintPath = TEXT("/SimpleAssetLibrary/tool/AssetLibrary.AssetLibrary");
+
+    // The material the entry thumbnails are drawn with
+    const TCHAR* ThumbnailMaterialPath = TEXT("/SimpleAssetLibrary/tool/materials/M_asset_thumbnail.M_asset_thumbnail");
+
+    // Tag of the actors placed from the Asset Library
+    const FName SpawnedActorTag(TEXT("Asset Library Spawned"));
+
+    // The config used when neither the project nor the plugin has a settings file
+    const TCHAR* DefaultAssetTypes[] = { TEXT("char"), TEXT("envir"), TEXT("FX"), TEXT("prop") };
+    const TCHAR* DefaultPlacedActorFolder = TEXT("placed");
+    const TCHAR* DefaultSharedLibraryPack = TEXT("AssetLibraryPack");
+
+    bool IsAllOption(const FString& Value)
+    {
+        return Value.Equals(SimpleAssetLibraryTags::All.ToString(), ESearchCase::IgnoreCase);
+    }
+
+    // Call a function of the window blueprint that takes no parameter, like get_asset_list
+    void CallPanelFunction(UEditorUtilityWidget* Panel, const TCHAR* FunctionName)
+    {
+        UFunction* Function = Panel->FindFunction(FName(FunctionName));
+        if (Function == nullptr || Function->ParmsSize > 0) {
+            UE_LOG(AssetLibrary, Warning, TEXT("The Asset Library window has no function %s without parameters"), FunctionName);
+            return;
+        }
+        Panel->ProcessEvent(Function, nullptr);
+    }
+
+    // Python sorts case-sensitively, keep the lists in the order the window always showed them in
+    void SortCaseSensitive(TArray<FString>& Values)
+    {
+        Values.Sort([](const FString& A, const FString& B) { return A.Compare(B, ESearchCase::CaseSensitive) < 0; });
+    }
+
+    TSharedPtr<FJsonObject> ReadJsonFile(const FString& Filename)
+    {
+        FString Text;
+        if (!FFileHelper::LoadFileToString(Text, *Filename)) {
+            return nullptr;
+        }
+        TSharedPtr<FJsonObject> Json;
+        if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Json) || !Json.IsValid()) {
+            UE_LOG(AssetLibrary, Warning, TEXT("%s is not a valid json file"), *Filename);
+            return nullptr;
+        }
+        return Json;
+    }
+
+    TArray<FString> GetStringArrayField(const FJsonObject& Json, const TCHAR* Field, const TArray<FString>& Default)
+    {
+        TArray<FString> Values;
+        return Json.TryGetStringArrayField(Field, Values) ? Values : Default;
+    }
+
+    // "SM_old_rock" -> "Sm Old Rock", like Python's str.title()
+    FString MakeTitleCase(const FString& Name)
+    {
+        FString Title = Name.Replace(TEXT("_"), TEXT(" "));
+        bool bWordStart = true;
+        for (TCHAR& Char : Title)
+        {
+            Char = bWordStart ? FChar::ToUpper(Char) : FChar::ToLower(Char);
+            bWordStart = !FChar::IsAlpha(Char);
+        }
+        return Title;
+    }
+
+    // Blueprint variables may be named "asset_data", "Asset Data" or "bIsNewEntryButton", compare them the way Python names them
+    FString GetScriptName(const FProperty& Property)
+    {
+        FString Name = Property.GetName();
+        if (Property.IsA<FBoolProperty>() && Name.Len() > 1 && Name[0] == TEXT('b') && FChar::IsUpper(Name[1])) {
+            Name.RightChopInline(1);
+        }
+        Name.ReplaceInline(TEXT(" "), TEXT(""));
+        Name.ReplaceInline(TEXT("_"), TEXT(""));
+        return Name.ToLower();
+    }
+
+    FProperty* FindEntryProperty(const UClass* EntryDataClass, const TCHAR* ScriptName)
+    {
+        const FString Wanted = FString(ScriptName).Replace(TEXT("_"), TEXT("")).ToLower();
+        for (TFieldIterator<FProperty> It(EntryDataClass); It; ++It)
+        {
+            if (GetScriptName(**It) == Wanted) {
+                return *It;
+            }
+        }
+        return nullptr;
+    }
+
+    // The properties of the window's entry data class, found once per call
+    struct FEntryProperties
+    {
+        FProperty* AssetData = nullptr;
+        FProperty* AssetPath = nullptr;
+        FProperty* AssetMetadata = nullptr;
+        FProperty* DisplayName = nullptr;
+        FProperty* AssetType = nullptr;
+        FProperty* Category = nullptr;
+        FProperty* AddedBy = nullptr;
+        FProperty* UnrealClass = nullptr;
+        FProperty* IsNewEntryButton = nullptr;
+        FProperty* ThumbnailMaterial = nullptr;
+
+        explicit FEntryProperties(const UClass* EntryDataClass)
+        : AssetData(FindEntryProperty(EntryDataClass, TEXT("asset_data")))
+        , AssetPath(FindEntryProperty(EntryDataClass, TEXT("asset_path")))
+        , AssetMetadata(FindEntryProperty(EntryDataClass, TEXT("asset_metadata")))
+        , DisplayName(FindEntryProperty(EntryDataClass, TEXT("asset_display_name")))
+        , AssetType(FindEntryProperty(EntryDataClass, TEXT("asset_type")))
+        , Category(FindEntryProperty(EntryDataClass, TEXT("asset_category")))
+        , AddedBy(FindEntryProperty(EntryDataClass, TEXT("added_by")))
+        , UnrealClass(FindEntryProperty(EntryDataClass, TEXT("unreal_class")))
+        , IsNewEntryButton(FindEntryProperty(EntryDataClass, TEXT("is_new_entry_button")))
+        , ThumbnailMaterial(FindEntryProperty(EntryDataClass, TEXT("thumbnail_material")))
+        {}
+    };
+
+    void SetEntryString(UObject* Entry, FProperty* Property, const FString& Value)
+    {
+        if (Property == nullptr) {
+            return;
+        }
+        void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Entry);
+        if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property)) {
+            StrProperty->SetPropertyValue(ValuePtr, Value);
+        }
+        else if (const FNameProperty* NameProperty = CastField<FNameProperty>(Property)) {
+            NameProperty->SetPropertyValue(ValuePtr, FName(*Value));
+        }
+        else if (const FTextProperty* TextProperty = CastField<FTextProperty>(Property)) {
+            TextProperty->SetPropertyValue(ValuePtr, FText::FromString(Value));
+        }
+    }
+
+    FString GetEntryString(const UObject* Entry, const FProperty* Property)
+    {
+        if (Property == nullptr) {
+            return FString();
+        }
+        const void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Entry);
+        if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property)) {
+            return StrProperty->GetPropertyValue(ValuePtr);
+        }
+        if (const FNameProperty* NameProperty = CastField<FNameProperty>(Property)) {
+            return NameProperty->GetPropertyValue(ValuePtr).ToString();
+        }
+        if (const FTextProperty* TextProperty = CastField<FTextProperty>(Property)) {
+            return TextProperty->GetPropertyValue(ValuePtr).ToString();
+        }
+        return FString();
+    }
+
+    void SetEntryBool(UObject* Entry, FProperty* Property, bool bValue)
+    {
+        if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property)) {
+            BoolProperty->SetPropertyValue_InContainer(Entry, bValue);
+        }
+    }
+
+    bool GetEntryBool(const UObject* Entry, const FProperty* Property)
+    {
+        const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property);
+        return BoolProperty && BoolProperty->GetPropertyValue_InContainer(Entry);
+    }
+
+    void SetEntryObject(UObject* Entry, FProperty* Property, UObject* Value)
+    {
+        const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property);
+        if (ObjectProperty && Value && Value->IsA(ObjectProperty->PropertyClass)) {
+            ObjectProperty->SetObjectPropertyValue_InContainer(Entry, Value);
+        }
+    }
+
+    void SetEntryAssetData(UObject* Entry, FProperty* Property, const FAssetData& AssetData)
+    {
+        const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+        if (StructProperty && StructProperty->Struct->GetFName() == TEXT("AssetData")) {
+            *StructProperty->ContainerPtrToValuePtr<FAssetData>(Entry) = AssetData;
+        }
+    }
+
+    // The metadata map is imported from its text form so it works for both string and name maps
+    void SetEntryMetadata(UObject* Entry, FProperty* Property, const TArray<TPair<FName, FString>>& Metadata)
+    {
+        if (!CastField<FMapProperty>(Property)) {
+            return;
+        }
+        FString Text = TEXT("(");
+        for (const TPair<FName, FString>& Pair : Metadata)
+        {
+            Text += FString::Printf(TEXT("%s(\"%s\", \"%s\")"), Text.Len() > 1 ? TEXT(",") : TEXT(""),
+                *Pair.Key.ToString(), *Pair.Value.ReplaceCharWithEscapedChar());
+        }
+        Text += TEXT(")");
+        Property->ImportText_InContainer(*Text, Entry, Entry, PPF_None);
+    }
+
+    IAssetRegistry& GetAssetRegistry()
+    {
+        return FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    }
+}
+
+
+USimpleAssetLibrarySubsystem*
+USimpleAssetLibrarySubsystem::Get()
+{
+    return GEditor ? GEditor->GetEditorSubsystem<USimpleAssetLibrarySubsystem>() : nullptr;
+}
+
+TArray<FString>
+USimpleAssetLibrarySubsystem::GetAvailableAssetTypes(bool bIncludeAllOption)
+{
+    LoadConfigIfNeeded();
+    TArray<FString> AssetTypes;
+    if (bIncludeAllOption) {
+        AssetTypes.Add(SimpleAssetLibraryTags::All.ToString());
+    }
+    AssetTypes.Append(ConfigAssetTypes);
+    return AssetTypes;
+}
+
+TArray<FString>
+USimpleAssetLibrarySubsystem::GetAvailableAssetCategories(const FString& AssetType, bool bIncludeAllOption)
+{
+    LoadConfigIfNeeded();
+    TSet<FString> UniqueCategories;
+    if (!IsAllOption(AssetType)) {
+        UniqueCategories.Append(ConfigDefaultCategories);
+    }
+
+    // the categories added by users come from the library index
+    FSimpleAssetLibraryIndex& Index = FSimpleAssetLibraryIndex::Get();
+    FSimpleAssetLibraryQueryArena& Arena = FSimpleAssetLibraryModule::Get().GetScriptQueryArena();
+    Arena.Reset();
+    for (int32 CategoryId : Index.GetCategoryIds(FName(*AssetType), Arena))
+    {
+        const FName Category = Index.GetNames().Categories.GetName(CategoryId);
+        if (!Category.IsNone()) {
+            UniqueCategories.Add(Category.ToString());
+        }
+    }
+
+    TArray<FString> Categories = UniqueCategories.Array();
+    SortCaseSensitive(Categories);
+    if (bIncludeAllOption) {
+        Categories.Insert(SimpleAssetLibraryTags::All.ToString(), 0);
+    }
+    return Categories;
+}
+
+TArray<FString>
+USimpleAssetLibrarySubsystem::GetDefaultCategories()
+{
+    LoadConfigIfNeeded();
+    return ConfigDefaultCategories;
+}
+
+FString
+USimpleAssetLibrarySubsystem::GetPlacedActorFolder()
+{
+    LoadConfigIfNeeded();
+    return ConfigPlacedActorFolder;
+}
+
+FString
+USimpleAssetLibrarySubsystem::GetSharedLibraryPackDirectory()
+{
+    LoadConfigIfNeeded();
+    if (ConfigSharedLibraryPack.IsEmpty()) {
+        return FString();
+    }
+    return FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / ConfigSharedLibraryPack);
+}
+
+TArray<FString>
+USimpleAssetLibrarySubsystem::GetLibraryScanRoots()
+{
+    LoadConfigIfNeeded();
+    return ConfigLibraryScanRoots;
+}
+
+FLinearColor
+USimpleAssetLibrarySubsystem::GetAssetTypeColor(const FString& AssetType)
+{
+    if (IsAllOption(AssetType)) {
+        return FLinearColor::White;
+    }
+
+    LoadConfigIfNeeded();
+    return FSimpleAssetLibraryTypeCatalog::Get().GetColor(FName(*AssetType));
+}
+
+TArray<FString>
+USimpleAssetLibrarySubsystem::GetUndeclaredAssetTypes()
+{
+    LoadConfigIfNeeded();
+    TArray<FString> AssetTypes;
+    for (const FName AssetType : FSimpleAssetLibraryTypeCatalog::Get().GetUndeclaredTypes())
+    {
+        AssetTypes.Add(AssetType.ToString());
+    }
+    return AssetTypes;
+}
+
+TArray<FString>
+USimpleAssetLibrarySubsystem::GetUnusedAssetTypes()
+{
+    LoadConfigIfNeeded();
+    TArray<FString> AssetTypes;
+    for (const FName AssetType : FSimpleAssetLibraryTypeCatalog::Get().GetUnusedTypes())
+    {
+        AssetTypes.Add(AssetType.ToString());
+    }
+    return AssetTypes;
+}
+
+void
+USimpleAssetLibrarySubsystem::ReloadConfig()
+{
+    bConfigLoaded = false;
+    LoadConfigIfNeeded();
+}
+
+bool
+USimpleAssetLibrarySubsystem::RegisterAsset(UObject* Asset, const FString& AssetType, const FString& Category, const FString& DisplayName)
+{
+    UEditorAssetSubsystem* AssetSubsystem = GEditor ? GEditor->GetEditorSubsystem<UEditorAssetSubsystem>() : nullptr;
+    if (Asset == nullptr || AssetSubsystem == nullptr) {
+        return false;
+    }
+
+    AssetSubsystem->SetMetadataTag(Asset, SimpleAssetLibraryTags::ManagedAsset, TEXT("True"));
+    AssetSubsystem->SetMetadataTag(Asset, SimpleAssetLibraryTags::AssetType, AssetType);
+    AssetSubsystem->SetMetadataTag(Asset, SimpleAssetLibraryTags::AssetCategory, Category);
+    AssetSubsystem->SetMetadataTag(Asset, SimpleAssetLibraryTags::DisplayName, DisplayName);
+    AssetSubsystem->SetMetadataTag(Asset, SimpleAssetLibraryTags::AddedBy, FPlatformProcess::UserName(false));
+    const bool bSaved = AssetSubsystem->SaveLoadedAsset(Asset, false);
+
+    const FName PackageName = Asset->GetPackage()->GetFName();
+    FSimpleAssetLibraryIndex::Get().RefreshPackage(PackageName);
+    UE_LOG(AssetLibrary, Log, TEXT("%s has been added to the Asset Library\ndetails:\n\tasset: %s\n\tdisplay name: %s\n\tasset type: %s\n\tcategory: %s"),
+        *PackageName.ToString(), *PackageName.ToString(), *DisplayName, *AssetType, *Category);
+    return bSaved;
+}
+
+bool
+USimpleAssetLibrarySubsystem::UnregisterAsset(UObject* Asset)
+{
+    UEditorAssetSubsystem* AssetSubsystem = GEditor ? GEditor->GetEditorSubsystem<UEditorAssetSubsystem>() : nullptr;
+    if (Asset == nullptr || AssetSubsystem == nullptr) {
+        return false;
+    }
+
+    for (const FName Tag : { SimpleAssetLibraryTags::ManagedAsset, SimpleAssetLibraryTags::AssetType, SimpleAssetLibraryTags::AssetCategory, SimpleAssetLibraryTags::DisplayName, SimpleAssetLibraryTags::AddedBy })
+    {
+        AssetSubsystem->RemoveMetadataTag(Asset, Tag);
+    }
+    const bool bSaved = AssetSubsystem->SaveLoadedAsset(Asset, true);
+
+    // rescan so the Asset Registry drops the tags of the saved package right away
+    const FString PackageName = Asset->GetPackage()->GetName();
+    GetAssetRegistry().ScanPathsSynchronous({ PackageName }, true);
+    FSimpleAssetLibraryIndex::Get().RefreshPackage(FName(*PackageName));
+    UE_LOG(AssetLibrary, Log, TEXT("%s has been removed from the Asset Library"), *PackageName);
+    return bSaved;
+}
+
+bool
+USimpleAssetLibrarySubsystem::GetAssetLibraryData(UObject* Asset, FString& AssetType, FString& Category, FString& DisplayName)
+{
+    AssetType.Reset();
+    Category.Reset();
+    DisplayName.Reset();
+    UEditorAssetSubsystem* AssetSubsystem = GEditor ? GEditor->GetEditorSubsystem<UEditorAssetSubsystem>() : nullptr;
+    if (Asset == nullptr || AssetSubsystem == nullptr) {
+        return false;
+    }
+
+    // "None" is what the metadata holds after it was cleared
+    auto GetTag = [AssetSubsystem, Asset](FName Tag)
+    {
+        FString Value = AssetSubsystem->GetMetadataTag(Asset, Tag);
+        return Value == TEXT("None") ? FString() : Value;
+    };
+    AssetType = GetTag(SimpleAssetLibraryTags::AssetType);
+    Category = GetTag(SimpleAssetLibraryTags::AssetCategory);
+    DisplayName = GetTag(SimpleAssetLibraryTags::DisplayName);
+    if (DisplayName.IsEmpty()) {
+        DisplayName = MakeTitleCase(Asset->GetName());
+    }
+    return GetTag(SimpleAssetLibraryTags::ManagedAsset).Equals(TEXT("true"), ESearchCase::IgnoreCase);
+}
+
+TArray<UObject*>
+USimpleAssetLibrarySubsystem::GetGuiEntries(TSubclassOf<UObject> EntryDataClass, const FString& AssetType, bool bAddNewEntryButton, UEditorUtilityWidget* Panel)
+{
+    TArray<UObject*> Entries;
+    if (EntryDataClass == nullptr) {
+        return Entries;
+    }
+
+    FSimpleAssetLibraryIndex& Index = FSimpleAssetLibraryIndex::Get();
+    FSimpleAssetLibraryQueryArena& Arena = FSimpleAssetLibraryModule::Get().GetScriptQueryArena();
+    Arena.Reset();
+    const TArrayView<int32> Rows = Index.Query(FName(*AssetType), SimpleAssetLibraryTags::All, Arena);
+
+    // The library data comes from the index columns, no asset is loaded to build the list
+    const FEntryProperties Properties(EntryDataClass);
+    Entries.Reserve(Rows.Num() + 1);
+
+    // The window's previous entries are replaced, their thumbnail materials are handed to the new ones
+    const int32 PanelIndex = FindPanel(Panel);
+    FSimpleAssetLibraryMaterialPool& MaterialPool = FSimpleAssetLibraryMaterialPool::Get();
+    UMaterialInterface* ThumbnailMaterialParent = nullptr;
+    if (PanelIndex != INDEX_NONE) {
+        ReleaseThumbnailMaterials(LibraryPanels[PanelIndex]);
+        if (Properties.ThumbnailMaterial) {
+            ThumbnailMaterialParent = LoadObject<UMaterialInterface>(nullptr, ThumbnailMaterialPath);
+        }
+    }
+    for (int32 Row : Rows)
+    {
+        FSimpleAssetLibraryEntryHandle Handle;
+        Handle.Row = Row;
+        Handle.Serial = Index.GetStore().GetSerial();
+        FSimpleAssetLibraryEntryInfo Info;
+        USimpleAssetLibraryBPLibrary::GetLibraryEntryInfo(Handle, Info);
+
+        // an unset asset type is interned as None, the window expects an empty string
+        const FString EntryAssetType = Info.AssetType.IsNone() ? FString() : Info.AssetType.ToString();
+        UObject* Entry = NewObject<UObject>(GetTransientPackage(), EntryDataClass);
+        SetEntryAssetData(Entry, Properties.AssetData, Info.AssetData);
+        SetEntryString(Entry, Properties.AssetPath, Info.AssetData.PackageName.ToString());
+        SetEntryMetadata(Entry, Properties.AssetMetadata, {
+            { SimpleAssetLibraryTags::ManagedAsset, TEXT("True") },
+            { SimpleAssetLibraryTags::AssetType, EntryAssetType },
+            { SimpleAssetLibraryTags::AssetCategory, Info.Category.ToString() },
+            { SimpleAssetLibraryTags::DisplayName, Info.DisplayName },
+            { SimpleAssetLibraryTags::AddedBy, Info.AddedBy.ToString() },
+        });
+        SetEntryString(Entry, Properties.DisplayName, Info.DisplayName);
+        SetEntryString(Entry, Properties.AssetType, EntryAssetType);
+        SetEntryString(Entry, Properties.Category, Info.Category.ToString());
+        SetEntryString(Entry, Properties.AddedBy, Info.AddedBy.ToString());
+        SetEntryString(Entry, Properties.UnrealClass, Info.UnrealClass.ToString());
+        if (UMaterialInstanceDynamic* ThumbnailMaterial = MaterialPool.Acquire(ThumbnailMaterialParent)) {
+            SetEntryObject(Entry, Properties.ThumbnailMaterial, ThumbnailMaterial);
+            LibraryPanels[PanelIndex].ThumbnailMaterials.Add(ThumbnailMaterial);
+        }
+        Entries.Add(Entry);
+    }
+
+    if (bAddNewEntryButton) {
+        UObject* NewEntryButton = NewObject<UObject>(GetTransientPackage(), EntryDataClass);
+        SetEntryBool(NewEntryButton, Properties.IsNewEntryButton, true);
+        Entries.Add(NewEntryButton);
+    }
+    UE_LOG(AssetLibrary, Log, TEXT("found %d registered assets of type %s"), Entries.Num(), *AssetType);
+    return Entries;
+}
+
+TArray<UObject*>
+USimpleAssetLibrarySubsystem::FilterGuiEntries(const TArray<UObject*>& Entries, const FSimpleAssetLibraryFilter& Filter)
+{
+    FSimpleAssetLibraryIndex& Index = FSimpleAssetLibraryIndex::Get();
+    FSimpleAssetLibraryQueryArena& Arena = FSimpleAssetLibraryModule::Get().GetScriptQueryArena();
+    Arena.Reset();
+    TSet<FName> MatchingPackages;
+    for (int32 Row : Index.Query(Filter, Arena))
+    {
+        MatchingPackages.Add(Index.GetStore().GetPackageNames()[Row]);
+    }
+
+    TArray<UObject*> FilteredEntries;
+    TArray<TPair<FName, UObject*>> MatchingEntries;
+    const UClass* EntryDataClass = nullptr;
+    TOptional<FEntryProperties> Properties;
+    for (UObject* Entry : Entries)
+    {
+        if (Entry == nullptr) {
+            continue;
+        }
+        if (Entry->GetClass() != EntryDataClass) {
+            EntryDataClass = Entry->GetClass();
+            Properties.Emplace(EntryDataClass);
+        }
+        if (GetEntryBool(Entry, Properties->IsNewEntryButton)) {
+            FilteredEntries.Add(Entry);
+            continue;
+        }
+        const FName PackageName(*GetEntryString(Entry, Properties->AssetPath));
+        if (MatchingPackages.Contains(PackageName)) {
+            MatchingEntries.Emplace(PackageName, Entry);
+        }
+    }
+
+    // search results are ranked by usage, the most placed entries first
+    if (!Filter.SearchText.IsEmpty()) {
+        FSimpleAssetLibraryUsage::Get().SortByUsage(MakeArrayView(MatchingEntries), [](const TPair<FName, UObject*>& MatchingEntry) { return MatchingEntry.Key; });
+    }
+    for (const TPair<FName, UObject*>& MatchingEntry : MatchingEntries)
+    {
+        FilteredEntries.Add(MatchingEntry.Value);
+    }
+    UE_LOG(AssetLibrary, Log, TEXT("%d/%d entries match the current display filter"), FilteredEntries.Num(), Entries.Num());
+    return FilteredEntries;
+}
+
+AActor*
+USimpleAssetLibrarySubsystem::SpawnAssetInViewport(UObject* Asset, const FString& DisplayName, const FSimpleAssetLibrarySpawnSettings& Settings)
+{
+    if (Asset == nullptr) {
+        return nullptr;
+    }
+    const double StartTime = FPlatformTime::Seconds();
+    const FString PackageName = Asset->GetPackage()->GetName();
+
+    FVector Origin;
+    FVector Direction;
+    if (!USimpleAssetLibraryBPLibrary::GetEditorViewportMousePositionWS(Origin, Direction)) {
+        UE_LOG(AssetLibrary, Warning, TEXT("Mouse is not currently over a viewport, cannot spawn %s"), *Asset->GetPathName());
+        return nullptr;
+    }
+    UWorld* World = GEditor->GetEditorSubsystem<UUnrealEditorSubsystem>()->GetEditorWorld();
+    UEditorActorSubsystem* ActorSubsystem = GEditor->GetEditorSubsystem<UEditorActorSubsystem>();
+
+    // [OPTIONAL] ignore actors spawned from the Asset Library
+    TArray<AActor*> ActorsToIgnore;
+    if (Settings.bIgnorePlacedAssets) {
+        UGameplayStatics::GetAllActorsWithTag(World, SpawnedActorTag, ActorsToIgnore);
+    }
+
+    // Find the surface under the mouse, or spawn in front of the camera if there's none close enough
+    FVector SpawnLocation = Direction * 1000.0f + Origin;
+    FVector SpawnNormal = FVector::UpVector;
+    FHitResult Hit;
+    const FVector Destination = Direction * Settings.MaxDistance + Origin;
+    if (UKismetSystemLibrary::SphereTraceSingle(World, Origin, Destination, 1.0f, ETraceTypeQuery::TraceTypeQuery1, true, ActorsToIgnore, EDrawDebugTrace::None, Hit, true)) {
+        SpawnLocation = Hit.Location;
+        SpawnNormal = Hit.Normal;
+    }
+    else {
+        UE_LOG(AssetLibrary, Warning, TEXT("No hit test results, will spawn 10 units in front of camera"));
+    }
+
+    FRotator SpawnRotation = FRotator::ZeroRotator;
+    if (Settings.bAlignToSurface) {
+        SpawnRotation = UKismetMathLibrary::ComposeRotators(FRotator(-90.0f, 0.0f, 0.0f), SpawnNormal.Rotation());
+    }
+
+    AActor* NewActor = ActorSubsystem->SpawnActorFromObject(Asset, SpawnLocation, SpawnRotation);
+    if (NewActor == nullptr) {
+        UE_LOG(AssetLibrary, Log, TEXT("Failed to spawn %s, it may not be a valid actor-compatible asset!"), *PackageName);
+        return nullptr;
+    }
+    NewActor->SetActorLabel(DisplayName);
+    NewActor->Tags.Add(SpawnedActorTag);
+
+    const FString ActorFolder = GetPlacedActorFolder();
+    if (!ActorFolder.IsEmpty()) {
+        NewActor->SetFolderPath(FName(*ActorFolder));
+    }
+    if (Settings.bSelectAfterSpawning) {
+        ActorSubsystem->SetSelectedLevelActors({ NewActor });
+    }
+
+    FSimpleAssetLibraryFavorites::Get().AddRecent(FName(*PackageName));
+    FSimpleAssetLibraryUsage::Get().RecordSpawn(FName(*PackageName), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    UE_LOG(AssetLibrary, Log, TEXT("Spawned asset %s from the Asset Library"), *PackageName);
+    return NewActor;
+}
+
+bool
+USimpleAssetLibrarySubsystem::SaveSettings(const FSimpleAssetLibraryPrefs& Prefs, FName PanelName)
+{
+    return FSimpleAssetLibraryPrefsStore::Get().Save(Prefs, PanelName);
+}
+
+bool
+USimpleAssetLibrarySubsystem::LoadSettings(FName PanelName, FSimpleAssetLibraryPrefs& Prefs)
+{
+    return FSimpleAssetLibraryPrefsStore::Get().Load(PanelName, Prefs);
+}
+
+FString
+USimpleAssetLibrarySubsystem::GetPrefsFilename()
+{
+    return FPaths::ProjectSavedDir() / TEXT("Config/asset_library_prefs.json");
+}
+
+UEditorUtilityWidget*
+USimpleAssetLibrarySubsystem::OpenLibraryPanel(FName PanelName)
+{
+    UEditorUtilityWidgetBlueprint* Blueprint = GetLibraryPanelBlueprint(true);
+    UEditorUtilitySubsystem* EditorUtilitySubsystem = GEditor ? GEditor->GetEditorSubsystem<UEditorUtilitySubsystem>() : nullptr;
+    if (Blueprint == nullptr || EditorUtilitySubsystem == nullptr) {
+        UE_LOG(AssetLibrary, Error, TEXT("Can't open the Asset Library, %s is missing"), LibraryPanelBlueprintPath);
+        return nullptr;
+    }
+
+    // The main window uses the blueprint's tab, the named ones a tab of their own.
+    // Spawning a tab that is open brings it to front, no widget is created then
+    RegisterCreatedPanel();
+    SpawningPanelName = PanelName;
+    if (PanelName.IsNone()) {
+        EditorUtilitySubsystem->SpawnAndRegisterTab(Blueprint);
+    }
+    else {
+        const FName TabId(*FString::Printf(TEXT("%s_%s"), LibraryPanelBlueprintPath, *PanelName.ToString()));
+        EditorUtilitySubsystem->SpawnAndRegisterTabWithId(Blueprint, TabId);
+        if (TSharedPtr<SDockTab> Tab = FGlobalTabmanager::Get()->FindExistingLiveTab(FTabId(TabId))) {
+            Tab->SetLabel(FText::Format(NSLOCTEXT("SimpleAssetLibrary", "NamedPanelLabel", "Asset Library - {0}"), FText::FromName(PanelName)));
+        }
+    }
+    RegisterCreatedPanel();
+    SpawningPanelName = NAME_None;
+
+    for (int32 Index = LibraryPanels.Num() - 1; Index >= 0; Index--)
+    {
+        if (LibraryPanels[Index].Name == PanelName) {
+            return LibraryPanels[Index].Widget.Get();
+        }
+    }
+    return nullptr;
+}
+
+void
+USimpleAssetLibrarySubsystem::RegisterLibraryPanel(UEditorUtilityWidget* Panel, FName PanelName)
+{
+    if (Panel == nullptr) {
+        return;
+    }
+    // Registering an open window again makes it the most recent one.
+    // The first window pins the recent and favorite entries and prefetches the most used ones, they're placed again the most
+    const int32 Index = FindPanel(Panel);
+    if (Index == INDEX_NONE) {
+        FSimpleAssetLibraryFavorites::Get();
+        FSimpleAssetLibraryUsage::Get().PrefetchMostUsed();
+        if (!EntriesChangedHandle.IsValid()) {
+            EntriesChangedHandle = FSimpleAssetLibraryIndex::Get().OnEntriesChanged().AddUObject(this, &USimpleAssetLibrarySubsystem::HandleEntriesChanged);
+        }
+        Panel->OnNativeDestruct.AddUObject(this, &USimpleAssetLibrarySubsystem::HandlePanelDestructed);
+    }
+    else {
+        // the window keeps its marked updates and its entries' materials
+        FLibraryPanel ExistingPanel = MoveTemp(LibraryPanels[Index]);
+        LibraryPanels.RemoveAt(Index);
+        ExistingPanel.Name = PanelName;
+        LibraryPanels.Add(MoveTemp(ExistingPanel));
+        return;
+    }
+    LibraryPanels.Add({ Panel, PanelName });
+}
+
+void
+USimpleAssetLibrarySubsystem::UnregisterLibraryPanel(UEditorUtilityWidget* Panel)
+{
+    const int32 Index = FindPanel(Panel);
+    if (Index != INDEX_NONE) {
+        ReleaseThumbnailMaterials(LibraryPanels[Index]);
+        LibraryPanels.RemoveAt(Index);
+        Panel->OnNativeDestruct.RemoveAll(this);
+    }
+}
+
+UEditorUtilityWidget*
+USimpleAssetLibrarySubsystem::GetLibraryPanel()
+{
+    RemoveClosedPanels();
+    RegisterCreatedPanel();
+
+    // The window being constructed restores its settings through the Python commands, they act on it
+    // even if another window is hovered or has the keyboard focus
+    UEditorUtilityWidget* Constructing = ConstructingPanel.Get();
+    if (Constructing && ConstructingPanelFrame == GFrameCounter && FindPanel(Constructing) != INDEX_NONE) {
+        return Constructing;
+    }
+
+    // The other Python commands act on the window the user is using
+    for (int32 Index = LibraryPanels.Num() - 1; Index >= 0; Index--)
+    {
+        UEditorUtilityWidget* Panel = LibraryPanels[Index].Widget.Get();
+        if (Panel->IsHovered() || Panel->HasFocusedDescendants()) {
+            return Panel;
+        }
+    }
+    return LibraryPanels.IsEmpty() ? nullptr : LibraryPanels.Last().Widget.Get();
+}
+
+TArray<UEditorUtilityWidget*>
+USimpleAssetLibrarySubsystem::GetLibraryPanels()
+{
+    RemoveClosedPanels();
+    RegisterCreatedPanel();
+    TArray<UEditorUtilityWidget*> Panels;
+    Panels.Reserve(LibraryPanels.Num());
+    for (const FLibraryPanel& Panel : LibraryPanels)
+    {
+        Panels.Add(Panel.Widget.Get());
+    }
+    return Panels;
+}
+
+FName
+USimpleAssetLibrarySubsystem::GetLibraryPanelName(UEditorUtilityWidget* Panel) const
+{
+    const int32 Index = FindPanel(Panel);
+    return Index != INDEX_NONE ? LibraryPanels[Index].Name : NAME_None;
+}
+
+UEditorUtilityWidgetBlueprint*
+USimpleAssetLibrarySubsystem::GetLibraryPanelBlueprint(bool bLoad)
+{
+    if (LibraryPanelBlueprint == nullptr) {
+        LibraryPanelBlueprint = bLoad
+            ? LoadObject<UEditorUtilityWidgetBlueprint>(nullptr, LibraryPanelBlueprintPath)
+            : FindObject<UEditorUtilityWidgetBlueprint>(nullptr, LibraryPanelBlueprintPath);
+    }
+    return LibraryPanelBlueprint;
+}
+
+void
+USimpleAssetLibrarySubsystem::MarkLibraryPanelDirty(UEditorUtilityWidget* Panel, int32 Dirty)
+{
+    RemoveClosedPanels();
+    RegisterCreatedPanel();
+    const int32 Index = FindPanel(Panel);
+    if (Index == INDEX_NONE || Dirty == 0) {
+        return;
+    }
+    LibraryPanels[Index].Dirty |= static_cast<ESimpleAssetLibraryPanelDirty>(Dirty);
+    if (!EndFrameHandle.IsValid()) {
+        EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &USimpleAssetLibrarySubsystem::HandleEndFrame);
+    }
+}
+
+bool
+USimpleAssetLibrarySubsystem::IsLibraryPanelUpdatePending(UEditorUtilityWidget* Panel) const
+{
+    const int32 Index = FindPanel(Panel);
+    return Index != INDEX_NONE && LibraryPanels[Index].Dirty != ESimpleAssetLibraryPanelDirty::None;
+}
+
+void
+USimpleAssetLibrarySubsystem::FlushLibraryPanels()
+{
+    if (EndFrameHandle.IsValid()) {
+        FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+        EndFrameHandle.Reset();
+    }
+    RemoveClosedPanels();
+
+    // the window's own functions get and lay out its entries, the ones marked again meanwhile wait for the next frame
+    const TArray<FLibraryPanel> Panels = LibraryPanels;
+    for (FLibraryPanel& Panel : LibraryPanels)
+    {
+        Panel.Dirty = ESimpleAssetLibraryPanelDirty::None;
+    }
+    for (const FLibraryPanel& Panel : Panels)
+    {
+        UEditorUtilityWidget* Widget = Panel.Widget.Get();
+        if (Widget == nullptr || Panel.Dirty == ESimpleAssetLibraryPanelDirty::None) {
+            continue;
+        }
+        if (EnumHasAnyFlags(Panel.Dirty, ESimpleAssetLibraryPanelDirty::Size)) {
+            CallPanelFunction(Widget, TEXT("update_entry_size"));
+        }
+        if (EnumHasAnyFlags(Panel.Dirty, ESimpleAssetLibraryPanelDirty::Type)) {
+            CallPanelFunction(Widget, TEXT("get_asset_list"));
+        }
+        if (EnumHasAnyFlags(Panel.Dirty, ESimpleAssetLibraryPanelDirty::Type | ESimpleAssetLibraryPanelDirty::Category | ESimpleAssetLibraryPanelDirty::Filter)) {
+            CallPanelFunction(Widget, TEXT("filter_asset_list"));
+        }
+    }
+}
+
+void
+USimpleAssetLibrarySubsystem::HandleEndFrame()
+{
+    FlushLibraryPanels();
+}
+
+void
+USimpleAssetLibrarySubsystem::HandlePanelDestructed(UUserWidget* Panel)
+{
+    UnregisterLibraryPanel(Cast<UEditorUtilityWidget>(Panel));
+}
+
+void
+USimpleAssetLibrarySubsystem::HandleEntriesChanged()
+{
+    RemoveClosedPanels();
+    if (LibraryPanels.Num() > 0) {
+        OnLibraryEntriesChanged.Broadcast();
+    }
+}
+
+void
+USimpleAssetLibrarySubsystem::RemoveClosedPanels()
+{
+    LibraryPanels.RemoveAll([](FLibraryPanel& Panel)
+    {
+        if (Panel.Widget.IsValid() && Panel.Widget->GetCachedWidget().IsValid()) {
+            return false;
+        }
+        ReleaseThumbnailMaterials(Panel);
+        return true;
+    });
+}
+
+void
+USimpleAssetLibrarySubsystem::ReleaseThumbnailMaterials(FLibraryPanel& Panel)
+{
+    FSimpleAssetLibraryMaterialPool& MaterialPool = FSimpleAssetLibraryMaterialPool::Get();
+    for (const TWeakObjectPtr<UMaterialInstanceDynamic>& ThumbnailMaterial : Panel.ThumbnailMaterials)
+    {
+        MaterialPool.Release(ThumbnailMaterial.Get());
+    }
+    Panel.ThumbnailMaterials.Reset();
+}
+
+UEditorUtilityWidget*
+USimpleAssetLibrarySubsystem::RegisterCreatedPanel()
+{
+    // The blueprint is only found, if it isn't loaded no window was ever opened
+    UEditorUtilityWidgetBlueprint* Blueprint = GetLibraryPanelBlueprint(false);
+    UEditorUtilityWidget* Panel = Blueprint ? Blueprint->GetCreatedWidget() : nullptr;
+    if (Panel == nullptr || !Panel->GetCachedWidget().IsValid() || FindPanel(Panel) != INDEX_NONE) {
+        return nullptr;
+    }
+    RegisterLibraryPanel(Panel, SpawningPanelName);
+    ConstructingPanel = Panel;
+    ConstructingPanelFrame = GFrameCounter;
+    return Panel;
+}
+
+int32
+USimpleAssetLibrarySubsystem::FindPanel(const UEditorUtilityWidget* Widget) const
+{
+    if (Widget == nullptr) {
+        return INDEX_NONE;
+    }
+    return LibraryPanels.IndexOfByPredicate([Widget](const FLibraryPanel& Panel) { return Panel.Widget.Get() == Widget; });
+}
+
+void
+USimpleAssetLibrarySubsystem::LoadConfigIfNeeded()
+{
+    if (bConfigLoaded) {
+        return;
+    }
+    bConfigLoaded = true;
+
+    // 1) the project settings, 2) the plugin's default settings, 3) the built-in defaults
+    TSharedPtr<FJsonObject> Json = ReadJsonFile(FPaths::ProjectConfigDir() / TEXT("simple_asset_library_settings.json"));
+    if (!Json.IsValid()) {
+        if (TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("SimpleAssetLibrary"))) {
+            Json = ReadJsonFile(Plugin->GetBaseDir() / TEXT("Config/simple_asset_library_settings.json"));
+        }
+    }
+
+    if (Json.IsValid()) {
+        ConfigAssetTypes = GetStringArrayField(*Json, TEXT("asset_types"), { TEXT("default") });
+        ConfigDefaultCategories = GetStringArrayField(*Json, TEXT("default_category_options"), { TEXT("default") });
+        ConfigPlacedActorFolder.Reset();
+        ConfigSharedLibraryPack.Reset();
+        Json->TryGetStringField(TEXT("placed_actor_folder"), ConfigPlacedActorFolder);
+        Json->TryGetStringField(TEXT("shared_library_pack"), ConfigSharedLibraryPack);
+        ConfigLibraryScanRoots = GetStringArrayField(*Json, TEXT("library_scan_roots"), { TEXT("/Game/") });
+    }
+    else {
+        ConfigAssetTypes = TArray<FString>(DefaultAssetTypes, UE_ARRAY_COUNT(DefaultAssetTypes));
+        ConfigDefaultCategories = { TEXT("default") };
+        ConfigPlacedActorFolder = DefaultPlacedActorFolder;
+        ConfigSharedLibraryPack = DefaultSharedLibraryPack;
+        ConfigLibraryScanRoots = { TEXT("/Game/") };
+    }
+    UE_LOG(AssetLibrary, Log, TEXT("Found the following asset types: %s"), *FString::Join(ConfigAssetTypes, TEXT(", ")));
+    FSimpleAssetLibraryTypeCatalog::Get().SetConfigTypes(ConfigAssetTypes);
+}
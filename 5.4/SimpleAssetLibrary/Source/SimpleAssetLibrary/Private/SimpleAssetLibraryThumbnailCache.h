@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IFileHandle;
+class UTexture2D;
+struct FAssetData;
+
+
+/*
+*	Append-only blob of compressed thumbnail images.
+*	Library entries keep the offset + size of their thumbnail, the blob itself has no table of contents.
+*	An image identical to one appended before is stored once, its entries share the same offset.
+*	The images of changed entries stay in the blob until the index compacts it when it saves its manifest.
+*/
+class FSimpleAssetLibraryThumbnailCache
+{
+public:
+	explicit FSimpleAssetLibraryThumbnailCache(const FString& InFilename);
+	~FSimpleAssetLibraryThumbnailCache();
+
+	/**  Read the image stored at the given location
+	 * @return  false if the location is outside of the blob or the read failed
+	 */
+	bool Read(int64 Offset, int32 Size, TArray<uint8>& OutData) const;
+
+	/**  Append the image to the blob, unless the same image was appended before
+	 * @return  the offset of the image in the blob, INDEX_NONE if it couldn't be written
+	 */
+	int64 Append(TConstArrayView<uint8> Data);
+
+	/** the number of appended images that were already in the blob */
+	int32 GetNumSharedImages() const { return NumSharedImages; }
+
+	/** the size of the blob in bytes, 0 if it doesn't exist */
+	int64 GetSize() const;
+
+	/**  Rewrite the blob with only the images still used, through a temp file that replaces it
+	 * @param  LiveImages  the offset + size of the images still used, the ones at the same offset are copied once
+	 * @param  OutOffsets  the new offset of each live image, in the same order
+	 * @return  false if the blob couldn't be rewritten, it's left as it was
+	 */
+	bool Compact(TConstArrayView<TPair<int64, int32>> LiveImages, TArray<int64>& OutOffsets);
+
+	/** Empty the blob, every previously returned offset becomes invalid */
+	void Reset();
+
+	const FString& GetFilename() const { return Filename; }
+
+private:
+	void CloseHandles();
+
+	FString Filename;
+	mutable TUniquePtr<IFileHandle> ReadHandle;
+	TUniquePtr<IFileHandle> WriteHandle;
+
+	/** the offset and size of the images appended this session, by content hash */
+	TMap<uint64, TPair<int64, int32>> ImagesByHash;
+	int32 NumSharedImages = 0;
+};
+
+
+namespace SimpleAssetLibraryThumbnails
+{
+	/**  Load the thumbnail saved in the asset's package and compress it to PNG
+	 * @return  false if the package doesn't exist or has no thumbnail for the asset
+	 */
+	bool LoadCompressedPackageThumbnail(const FAssetData& AssetData, TArray64<uint8>& OutCompressedImage, int32& OutWidth, int32& OutHeight);
+
+	/**  Create a transient texture of raw BGRA8 pixels, the pixels are uploaded on the render thread
+	 * the texture has no CPU mip, the pixels are moved into the upload command and its resource mustn't be updated again
+	 * @return  the transient texture, nullptr if the pixels don't match the size
+	 */
+	UTexture2D* CreateThumbnailTexture(TArray<uint8>&& Pixels, int32 Width, int32 Height);
+
+	/**  Create a texture of the asset's thumbnail, from the library index cache or else from its package
+	 * thumbnails loaded from the package are added to the index cache for the next time
+	 * @return  the transient thumbnail texture, nullptr if the asset has no thumbnail
+	 */
+	UTexture2D* LoadLibraryThumbnailTexture(const FAssetData& AssetData, int32& OutWidth, int32& OutHeight);
+
+	/**  Get the thumbnail texture of a library entry, shared by the tiles of every Asset Library window
+	 * entries with byte-identical thumbnails (instances of one material, default class icons) share a single texture
+	 * the textures are only weakly referenced, a texture is created again once no tile kept it from being garbage collected
+	 * @return  the transient thumbnail texture, nullptr if the asset has no thumbnail
+	 */
+	UTexture2D* GetSharedLibraryThumbnailTexture(const FAssetData& AssetData);
+
+	/**  Count the shared thumbnail textures in use
+	 * @param  OutNumEntries  the library entries showing a thumbnail texture
+	 * @param  OutNumTextures  the distinct textures they show
+	 */
+	void GetSharedLibraryThumbnailTextureCounts(int32& OutNumEntries, int32& OutNumTextures);
+
+	/** Share the thumbnail texture of a renamed or moved library entry under its new package name, the image didn't change */
+	void RenameSharedLibraryThumbnailTexture(FName OldPackageName, FName NewPackageName);
+
+	/** Stop sharing the thumbnail texture of a deleted library entry, the tiles still showing it keep it alive */
+	void ForgetSharedLibraryThumbnailTexture(FName PackageName);
+}
@@ -0,0 +1,306 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SimpleAssetLibraryTileView.h"
+#include "SimpleAssetLibraryIndex.h"
+#include "SimpleAssetLibraryUsage.h"
+#include "SSimpleAssetLibraryTile.h"
+
+#include "Engine/Texture2D.h"
+
+#define LOCTEXT_NAMESPACE "SimpleAssetLibrary"
+
+
+void
+USimpleAssetLibraryTileView::SetQuery(FName AssetType, FName Category)
+{
+    Filter.AssetTypes = { AssetType };
+    Filter.Categories = { Category };
+    MarkDirty(ESimpleAssetLibraryViewDirty::Query);
+}
+
+void
+USimpleAssetLibraryTileView::SetSearchText(const FString& Text)
+{
+    Filter.SearchText = Text;
+    MarkDirty(ESimpleAssetLibraryViewDirty::Query);
+}
+
+void
+USimpleAssetLibraryTileView::SetFilter(const FSimpleAssetLibraryFilter& InFilter)
+{
+    Filter = InFilter;
+    MarkDirty(ESimpleAssetLibraryViewDirty::Query);
+}
+
+void
+USimpleAssetLibraryTileView::SetEntryScale(float Scale)
+{
+    EntryScale = FMath::Max(Scale, 0.1f);
+    MarkDirty(ESimpleAssetLibraryViewDirty::Layout);
+}
+
+void
+USimpleAssetLibraryTileView::Refresh()
+{
+    MarkDirty(ESimpleAssetLibraryViewDirty::Query);
+}
+
+void
+USimpleAssetLibraryTileView::FlushRefresh()
+{
+    if (TSharedPtr<FActiveTimerHandle> Timer = RefreshTimer.Pin()) {
+        if (TileView) {
+            TileView->UnRegisterActiveTimer(Timer.ToSharedRef());
+        }
+    }
+    RefreshTimer.Reset();
+
+    const ESimpleAssetLibraryViewDirty Flushed = Dirty;
+    Dirty = ESimpleAssetLibraryViewDirty::None;
+    if (EnumHasAnyFlags(Flushed, ESimpleAssetLibraryViewDirty::Query)) {
+        UpdateItems();
+    }
+    if (EnumHasAnyFlags(Flushed, ESimpleAssetLibraryViewDirty::Layout)) {
+        UpdateTileSize();
+    }
+}
+
+int32
+USimpleAssetLibraryTileView::GetNumEntries()
+{
+    if (EnumHasAnyFlags(Dirty, ESimpleAssetLibraryViewDirty::Query)) {
+        FlushRefresh();
+    }
+    return Items.Num();
+}
+
+void
+USimpleAssetLibraryTileView::MarkDirty(ESimpleAssetLibraryViewDirty InDirty)
+{
+    Dirty |= InDirty;
+
+    // a view that isn't constructed yet is updated when it is
+    if (TileView && !RefreshTimer.IsValid()) {
+        RefreshTimer = TileView->RegisterActiveTimer(0.0f,
+            FWidgetActiveTimerDelegate::CreateUObject(this, &USimpleAssetLibraryTileView::HandleRefreshTimer));
+    }
+}
+
+EActiveTimerReturnType
+USimpleAssetLibraryTileView::HandleRefreshTimer(double InCurrentTime, float InDeltaTime)
+{
+    RefreshTimer.Reset();
+    FlushRefresh();
+    return EActiveTimerReturnType::Stop;
+}
+
+void
+USimpleAssetLibraryTileView::HandleEntriesChanged()
+{
+    // entries were renamed, moved or deleted, the items hold rows that may be stale
+    MarkDirty(ESimpleAssetLibraryViewDirty::Query);
+}
+
+void
+USimpleAssetLibraryTileView::UpdateItems()
+{
+    FSimpleAssetLibraryIndex& Index = FSimpleAssetLibraryIndex::Get();
+    QueryArena.Reset();
+    const TArrayView<int32> Rows = Index.Query(Filter, QueryArena);
+    if (bRankSearchResultsByUsage && !Filter.SearchText.IsEmpty()) {
+        FSimpleAssetLibraryUsage::Get().SortByUsage(Rows);
+    }
+
+    // items only hold a row + serial, the tiles read the entry data when they become visible.
+    // A row keeps its item until the rows move, so the view's selection follows the entries across queries
+    const FSimpleAssetLibraryEntryStore& Store = Index.GetStore();
+    const int32 Serial = Store.GetSerial();
+    const bool bRowsMoved = ItemsSerial != Serial;
+    if (bRowsMoved) {
+        ItemsByRow.Reset();
+        ItemsSerial = Serial;
+    }
+    for (int32 Row = ItemsByRow.Num(); Row < Store.Num(); Row++)
+    {
+        FItem& Item = ItemsByRow.Add_GetRef(MakeShared<FSimpleAssetLibraryEntryHandle>());
+        Item->Row = Row;
+        Item->Serial = Serial;
+    }
+
+    Items.Reset(Rows.Num());
+    for (const int32 Row : Rows)
+    {
+        Items.Add(ItemsByRow[Row]);
+    }
+
+    // the tiles of the items of moved rows are stale, the list is only rebuilt then
+    if (TileView && bRowsMoved) {
+        TileView->RebuildList();
+    }
+    else if (TileView) {
+        TileView->RequestListRefresh();
+    }
+}
+
+TArray<FSimpleAssetLibraryEntryInfo>
+USimpleAssetLibraryTileView::GetSelectedEntries() const
+{
+    TArray<FSimpleAssetLibraryEntryInfo> Entries;
+    if (TileView) {
+        for (const FItem& Item : TileView->GetSelectedItems())
+        {
+            FSimpleAssetLibraryEntryInfo Info;
+            if (GetItemInfo(Item, Info)) {
+                Entries.Add(MoveTemp(Info));
+            }
+        }
+    }
+    return Entries;
+}
+
+void
+USimpleAssetLibraryTileView::PrefetchSelectedEntries()
+{
+    for (const FSimpleAssetLibraryEntryInfo& Entry : GetSelectedEntries())
+    {
+        USimpleAssetLibraryBPLibrary::PrefetchLibraryEntry(Entry.AssetData.PackageName);
+    }
+}
+
+void
+USimpleAssetLibraryTileView::SynchronizeProperties()
+{
+    Super::SynchronizeProperties();
+    UpdateTileSize();
+}
+
+void
+USimpleAssetLibraryTileView::UpdateTileSize()
+{
+    if (TileView) {
+        const FVector2D TileSize(EntryWidth * EntryScale, EntryHeight * EntryScale);
+        TileView->SetItemWidth(TileSize.X);
+        TileView->SetItemHeight(TileSize.Y);
+        for (const TSharedRef<SSimpleAssetLibraryTile>& Tile : TilePool)
+        {
+            Tile->SetTileSize(TileSize);
+        }
+        for (const TPair<const ITableRow*, TSharedRef<SSimpleAssetLibraryTile>>& Pair : TilesByRow)
+        {
+            Pair.Value->SetTileSize(TileSize);
+        }
+        TileView->RequestListRefresh();
+    }
+}
+
+void
+USimpleAssetLibraryTileView::ReleaseSlateResources(bool bReleaseChildren)
+{
+    Super::ReleaseSlateResources(bReleaseChildren);
+
+    if (EntriesChangedHandle.IsValid()) {
+        FSimpleAssetLibraryIndex::Get().OnEntriesChanged().Remove(EntriesChangedHandle);
+        EntriesChangedHandle.Reset();
+    }
+    TileView.Reset();
+    RefreshTimer.Reset();
+    TilePool.Reset();
+    TilesByRow.Reset();
+}
+
+#if WITH_EDITOR
+const FText
+USimpleAssetLibraryTileView::GetPaletteCategory()
+{
+    return LOCTEXT("AssetLibrary", "Asset Library");
+}
+#endif
+
+TSharedRef<SWidget>
+USimpleAssetLibraryTileView::RebuildWidget()
+{
+    // the changes made before the view was constructed, the new tile view is laid out with the current size anyway
+    if (EnumHasAnyFlags(Dirty, ESimpleAssetLibraryViewDirty::Query)) {
+        UpdateItems();
+    }
+    Dirty = ESimpleAssetLibraryViewDirty::None;
+
+    if (!EntriesChangedHandle.IsValid()) {
+        EntriesChangedHandle = FSimpleAssetLibraryIndex::Get().OnEntriesChanged().AddUObject(this, &USimpleAssetLibraryTileView::HandleEntriesChanged);
+    }
+
+    TileView = SNew(STileView<FItem>)
+        .ListItemsSource(&Items)
+        .ItemWidth(EntryWidth * EntryScale)
+        .ItemHeight(EntryHeight * EntryScale)
+        .SelectionMode(ESelectionMode::Multi)
+        .OnGenerateTile_UObject(this, &USimpleAssetLibraryTileView::GenerateTile)
+        .OnRowReleased_UObject(this, &USimpleAssetLibraryTileView::ReleaseTile)
+        .OnMouseButtonClick_UObject(this, &USimpleAssetLibraryTileView::HandleClick)
+        .OnMouseButtonDoubleClick_UObject(this, &USimpleAssetLibraryTileView::HandleDoubleClick);
+
+    return TileView.ToSharedRef();
+}
+
+TSharedRef<ITableRow>
+USimpleAssetLibraryTileView::GenerateTile(FItem Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    // reuse a released tile, only the visible rows ever own a tile
+    TSharedPtr<SSimpleAssetLibraryTile> Tile;
+    if (TilePool.Num() > 0) {
+        Tile = TilePool.Pop();
+    }
+    else {
+        Tile = SNew(SSimpleAssetLibraryTile);
+        Tile->SetTileSize(FVector2D(EntryWidth * EntryScale, EntryHeight * EntryScale));
+    }
+
+    FSimpleAssetLibraryEntryInfo Info;
+    if (GetItemInfo(Item, Info)) {
+        Tile->SetEntry(Info, DefaultThumbnail);
+    }
+    else {
+        Tile->ClearEntry();
+    }
+
+    TSharedRef<STableRow<FItem>> Row = SNew(STableRow<FItem>, OwnerTable)
+        [
+            Tile.ToSharedRef()
+        ];
+    TilesByRow.Add(&Row.Get(), Tile.ToSharedRef());
+    return Row;
+}
+
+void
+USimpleAssetLibraryTileView::ReleaseTile(const TSharedRef<ITableRow>& Row)
+{
+    TSharedRef<SSimpleAssetLibraryTile> Tile = TilesByRow.FindAndRemoveChecked(&Row.Get());
+    Tile->ClearEntry();
+    TilePool.Add(Tile);
+}
+
+void
+USimpleAssetLibraryTileView::HandleClick(FItem Item)
+{
+    FSimpleAssetLibraryEntryInfo Info;
+    if (GetItemInfo(Item, Info)) {
+        OnEntryClicked.Broadcast(Info);
+    }
+}
+
+void
+USimpleAssetLibraryTileView::HandleDoubleClick(FItem Item)
+{
+    FSimpleAssetLibraryEntryInfo Info;
+    if (GetItemInfo(Item, Info)) {
+        OnEntryDoubleClicked.Broadcast(Info);
+    }
+}
+
+bool
+USimpleAssetLibraryTileView::GetItemInfo(const FItem& Item, FSimpleAssetLibraryEntryInfo& OutInfo) const
+{
+    return Item.IsValid() && USimpleAssetLibraryBPLibrary::GetLibraryEntryInfo(*Item, OutInfo);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,60 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SimpleAssetLibraryFilter.generated.h"
+
+
+/** The criteria of a library filter, each value of a criterion has a bitset of its entries */
+UENUM(BlueprintType)
+enum class ESimpleAssetLibraryFilterCriterion : uint8
+{
+	AssetType,
+	Category,
+	AddedBy,
+	UnrealClass,
+
+	Num UMETA(Hidden)
+};
+
+/*
+*	A compound filter of the library entries.
+*	Values of the same criterion are OR'ed, the criteria are AND'ed and an empty criterion matches every entry.
+*	'all' in a criterion also matches every entry, so the values of the GUI combo boxes can be used as they are.
+*/
+USTRUCT(BlueprintType)
+struct SIMPLEASSETLIBRARY_API FSimpleAssetLibraryFilter
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Library")
+	TArray<FName> AssetTypes;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Library")
+	TArray<FName> Categories;
+
+	/** the users who added the entries, e.g. the current user for "added by me" */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Library")
+	TArray<FName> AddedBy;
+
+	/** the classes of the entries, as full class paths like /Script/Engine.StaticMesh or class names like StaticMesh */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Library")
+	TArray<FString> UnrealClasses;
+
+	/** whether the entries of classes derived from UnrealClasses match too, e.g. Texture matches Texture2D and TextureCube */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Library")
+	bool bIncludeDerivedClasses = false;
+
+	/** only keep the entries whose display name or asset name contains this text */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Library")
+	FString SearchText;
+
+	bool operator==(const FSimpleAssetLibraryFilter& Other) const
+	{
+		return AssetTypes == Other.AssetTypes && Categories == Other.Categories && AddedBy == Other.AddedBy
+			&& UnrealClasses == Other.UnrealClasses && bIncludeDerivedClasses == Other.bIncludeDerivedClasses
+			&& SearchText.Equals(Other.SearchText, ESearchCase::CaseSensitive);
+	}
+	bool operator!=(const FSimpleAssetLibraryFilter& Other) const { return !(*this == Other); }
+};
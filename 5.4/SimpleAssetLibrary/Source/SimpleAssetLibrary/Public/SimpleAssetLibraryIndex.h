@@ -0,0 +1,238 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Containers/Ticker.h"
+#include "SimpleAssetLibraryEntryStore.h"
+#include "SimpleAssetLibraryFilter.h"
+
+class FSimpleAssetLibraryFilterBits;
+class FSimpleAssetLibraryNameSearch;
+class FSimpleAssetLibraryPack;
+class FSimpleAssetLibraryQueryArena;
+class FSimpleAssetLibraryThumbnailCache;
+class SNotificationItem;
+
+/** Broadcast when the entries of the library index changed, rows may have moved */
+DECLARE_MULTICAST_DELEGATE(FOnSimpleAssetLibraryEntriesChanged);
+
+
+/*
+*	Native index of the assets registered to the Asset Library.
+*
+*	The first time it's needed the index is restored from the binary manifest in Saved/ so the
+*	library can open without enumerating the Asset Registry. The restored entries are then
+*	validated against the Asset Registry in small batches over the following frames.
+*	If no usable manifest exists the index is built from the Asset Registry directly.
+*
+*	When a shared library pack is configured, the local manifest is seeded from the pack and only
+*	holds the local changes on top of it, thumbnails of unchanged entries are read from the pack.
+*
+*	When the library is first opened while the Asset Registry is still discovering assets, the index
+*	is built from the package headers on disk instead, then the assets are added as they are
+*	discovered and a notification shows the progress until the discovery is done. The entries the
+*	Asset Registry doesn't know once it's done are dropped.
+*
+*	Once initialized the index follows the renames, moves and deletes of its entries in the editor.
+*	The affected packages are patched on the next tick, together, and the open windows are notified.
+*/
+class SIMPLEASSETLIBRARY_API FSimpleAssetLibraryIndex
+{
+public:
+	FSimpleAssetLibraryIndex();
+	~FSimpleAssetLibraryIndex();
+
+	/** Get the index owned by the SimpleAssetLibrary module, it is initialized on first use */
+	static FSimpleAssetLibraryIndex& Get();
+
+	/** Restore the index from the manifest or the shared pack, or build it from the Asset Registry if both fail */
+	void Initialize();
+
+	/** Rebuild the index from the Asset Registry, cached thumbnails of existing entries are kept */
+	void Rebuild();
+
+	/** Re-read a single package from the Asset Registry, adding, updating or removing its entry */
+	void RefreshPackage(FName PackageName);
+
+	/** Broadcast after the entries changed: a refresh, a rebuild or the assets renamed or deleted in the editor */
+	FOnSimpleAssetLibraryEntriesChanged& OnEntriesChanged() { return EntriesChanged; }
+
+	/**  Get the entries matching the given asset type and category, in sort order
+	 * @param  AssetType  the asset type to match, 'all' matches every type
+	 * @param  Category  the category to match, 'all' matches every category
+	 * @param  Arena  the scratch memory of the query, the result is valid until the arena is reset
+	 * @return  the matching rows of GetStore()
+	 */
+	TArrayView<int32> Query(FName AssetType, FName Category, FSimpleAssetLibraryQueryArena& Arena) const;
+
+	/**  Get the entries matching a compound filter, in sort order
+	 * @param  Filter  the criteria and search text to match
+	 * @param  Arena  the scratch memory of the query, the result is valid until the arena is reset
+	 * @return  the matching rows of GetStore()
+	 */
+	TArrayView<int32> Query(const FSimpleAssetLibraryFilter& Filter, FSimpleAssetLibraryQueryArena& Arena) const;
+
+	/** the number of entries matching a compound filter */
+	int32 Count(const FSimpleAssetLibraryFilter& Filter, FSimpleAssetLibraryQueryArena& Arena) const;
+
+	/**  Count the entries of each value of a criterion, the other criteria of the filter still apply
+	 * @param  Filter  the filter, its values for the counted criterion are ignored
+	 * @param  Criterion  the criterion to count the values of
+	 * @param  Arena  the scratch memory of the query, the result is valid until the arena is reset
+	 * @return  the number of matching entries per value id, see GetCriterionValue()
+	 */
+	TArrayView<int32> CountByValue(const FSimpleAssetLibraryFilter& Filter, ESimpleAssetLibraryFilterCriterion Criterion, FSimpleAssetLibraryQueryArena& Arena) const;
+
+	/** the value of a criterion value id, classes are returned as their full path */
+	FName GetCriterionValue(ESimpleAssetLibraryFilterCriterion Criterion, int32 ValueId) const;
+
+	/**  Keep the rows whose display name or asset name contains the given text, case-insensitive
+	 * @param  Text  the text to search for, an empty text keeps every row
+	 * @param  Rows  the rows of GetStore() to filter, they are filtered in place and their order is kept
+	 * @param  Arena  the scratch memory of the query
+	 * @return  the front of Rows holding the matching rows
+	 */
+	TArrayView<int32> FilterByName(const FString& Text, TArrayView<int32> Rows, FSimpleAssetLibraryQueryArena& Arena) const;
+
+	/**  Get the categories used by the entries of the given asset type
+	 * @param  AssetType  the asset type, 'all' gets the categories of every type
+	 * @param  Arena  the scratch memory of the query, the result is valid until the arena is reset
+	 * @return  the category ids, in id order
+	 */
+	TArrayView<int32> GetCategoryIds(FName AssetType, FSimpleAssetLibraryQueryArena& Arena) const;
+
+	const FSimpleAssetLibraryEntryStore& GetStore() const { return Store; }
+	const FSimpleAssetLibraryNames& GetNames() const { return Store.GetNames(); }
+
+	/** whether restored manifest entries are still being validated against the Asset Registry */
+	bool IsValidating() const { return ValidationTickerHandle.IsValid(); }
+
+	/** whether the Asset Registry is still discovering assets, the index may be missing entries until it's done */
+	bool IsDiscovering() const { return bDiscovering; }
+
+	/** the fraction of the assets the Asset Registry discovered so far, 1 once it's done */
+	float GetDiscoveryProgress() const { return bDiscovering ? DiscoveryProgress : 1.0f; }
+
+	/** Write the index to the manifest file if it changed since it was loaded or last saved */
+	bool SaveManifest();
+
+	/**  Get the cached compressed thumbnail of a library entry
+	 * @return  false if the entry has no cached thumbnail
+	 */
+	bool LoadCachedThumbnail(FName PackageName, TArray<uint8>& OutCompressedImage, int32& OutWidth, int32& OutHeight) const;
+
+	/** Store the compressed thumbnail of a library entry in the thumbnail cache */
+	void CacheThumbnail(FName PackageName, TConstArrayView<uint8> CompressedImage, int32 Width, int32 Height);
+
+	/**  Export the index and the thumbnails of every entry as a shared library pack
+	 * @param  Directory  the pack folder, usually a folder in the project distributed by source control
+	 * @return  whether the pack was written
+	 */
+	bool ExportSharedPack(const FString& Directory);
+
+	/** <project>/Saved/SimpleAssetLibrary/LibraryManifest.bin */
+	static FString GetManifestFilename();
+
+	/** <project>/Saved/SimpleAssetLibrary/LibraryThumbnails.bin */
+	static FString GetThumbnailCacheFilename();
+
+private:
+	bool LoadManifest();
+	bool MountSharedPack();
+
+	/** Rewrite the thumbnail cache without the images of changed or removed entries, once they take enough of it */
+	void CompactThumbnailCacheIfNeeded();
+
+	/** the filter bitsets, rebuilt if the store changed since they were built */
+	const FSimpleAssetLibraryFilterBits& GetFilterBits() const;
+
+	/**  Evaluate a filter to the bitset of its matching rows
+	 * @param  IgnoredCriterion  a criterion of the filter to skip, Num to apply them all
+	 */
+	TArrayView<uint64> EvaluateFilter(const FSimpleAssetLibraryFilter& Filter, ESimpleAssetLibraryFilterCriterion IgnoredCriterion, FSimpleAssetLibraryQueryArena& Arena) const;
+
+	/**  Resolve the values of a filter criterion to value ids, unknown values are dropped
+	 * @return  false if the criterion matches every row: it has no value or one of them is 'all'
+	 */
+	bool ResolveCriterion(const FSimpleAssetLibraryFilter& Filter, ESimpleAssetLibraryFilterCriterion Criterion, TArray<int32, TInlineAllocator<16>>& OutValueIds) const;
+
+	/** one flag per row, set for the rows with a name containing the text */
+	TArrayView<bool> FindNameMatches(const FString& Text, FSimpleAssetLibraryQueryArena& Arena) const;
+	void StartValidation();
+	bool TickValidation(float DeltaTime);
+	void FinishValidation();
+	void FindRegisteredAssets(TArray<FAssetData>& OutAssets) const;
+
+	/**  Update the entry of a package from the Asset Registry, the store is left unsorted
+	 * @return  whether the entry was added, updated or removed
+	 */
+	bool UpdatePackage(FName PackageName);
+
+	/** Sort the store after entries were updated and let the listeners know */
+	void FinishUpdate();
+
+	/**  Follow the Asset Registry discovery until it's done
+	 * @param  bPopulate  whether to add the managed assets as they are discovered, when the index wasn't restored
+	 */
+	void StartDiscovery(bool bPopulate);
+	/** Build the index from the package headers of the library scan roots and the assets discovered so far */
+	void ScanPackages();
+	void HandleAssetsDiscovered(TConstArrayView<FAssetData> Assets);
+	void HandleDiscoveryProgress(const IAssetRegistry::FFileLoadProgressUpdateData& ProgressData);
+	void HandleFilesLoaded();
+	void UpdateDiscoveryNotification();
+
+	void HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void HandleAssetRemoved(const FAssetData& AssetData);
+	void HandleInMemoryAssetDeleted(UObject* Object);
+
+	/** Queue a package to be updated or removed on the next tick, a later change of the package replaces it */
+	void QueuePackage(FName PackageName, bool bRemove);
+	bool TickPendingPackages(float DeltaTime);
+
+	FSimpleAssetLibraryEntryStore Store;
+	TUniquePtr<FSimpleAssetLibraryThumbnailCache> ThumbnailCache;
+
+	/** lowercase names of the store rows, rebuilt by the first search after the store changed */
+	TUniquePtr<FSimpleAssetLibraryNameSearch> NameSearch;
+
+	/** per-value row bitsets of the filter criteria, rebuilt by the first filter after the store changed */
+	TUniquePtr<FSimpleAssetLibraryFilterBits> FilterBits;
+	TUniquePtr<FSimpleAssetLibraryPack> SharedPack;
+
+	/** the shared pack the entries were seeded from, invalid if they weren't */
+	FGuid SeedPackId;
+
+	FTSTicker::FDelegateHandle ValidationTickerHandle;
+	TBitArray<> InvalidEntries;
+	int32 ValidationCursor = 0;
+
+	/** the validated packages whose file changed since they were indexed */
+	int32 NumChangedPackages = 0;
+
+	/** the packages renamed, moved or deleted in the editor since the last tick, true for the ones to remove */
+	TMap<FName, bool> PendingPackages;
+
+	/** the entries of the renamed packages by new package name, their thumbnails move with them */
+	TMap<FName, FSimpleAssetLibraryEntry> RenamedEntries;
+	FTSTicker::FDelegateHandle PendingTickerHandle;
+
+	/** the Asset Registry discovery, followed while the index is first used before it's done */
+	FDelegateHandle AssetsDiscoveredHandle;
+	FDelegateHandle DiscoveryProgressHandle;
+	FDelegateHandle FilesLoadedHandle;
+	TSharedPtr<SNotificationItem> DiscoveryNotification;
+	float DiscoveryProgress = 0.0f;
+	int32 NumDiscoveredEntries = 0;
+	bool bDiscovering = false;
+
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle InMemoryAssetDeletedHandle;
+	FOnSimpleAssetLibraryEntriesChanged EntriesChanged;
+
+	bool bInitialized = false;
+	bool bDirty = false;
+};
@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+
+class UPackage;
+class FObjectPostSaveContext;
+
+
+/* The packages loaded with a library entry: its own package and the closure of its hard package dependencies */
+struct FSimpleAssetLibraryLoadSet
+{
+	/** the entry package first, then its dependencies, script packages are left out */
+	TArray<FName> Packages;
+
+	/** the size on disk of every package of the set */
+	int64 DiskSize = 0;
+
+	int32 NumDependencies() const { return FMath::Max(Packages.Num() - 1, 0); }
+};
+
+
+/*
+*	Load set estimates and prefetching of the library entries.
+*
+*	The load set of an entry is resolved from the Asset Registry dependencies the first time it's
+*	asked for and cached, the cache is dropped whenever a package is saved since its dependencies
+*	may have changed. A prefetch async loads an entry with its dependencies before it is placed,
+*	the most recent prefetches are kept loaded until newer ones replace them. Pinned entries are
+*	loaded the same way and stay loaded until they're unpinned.
+*/
+class SIMPLEASSETLIBRARY_API FSimpleAssetLibraryLoadSets
+{
+public:
+	FSimpleAssetLibraryLoadSets();
+	~FSimpleAssetLibraryLoadSets();
+
+	/** Get the load sets owned by the SimpleAssetLibrary module */
+	static FSimpleAssetLibraryLoadSets& Get();
+
+	/**  Get the load set of a package, resolved from the Asset Registry on first use
+	 * @param  PackageName  the long package name of a library entry
+	 * @return  the cached load set, valid until the next call
+	 */
+	const FSimpleAssetLibraryLoadSet& GetLoadSet(FName PackageName);
+
+	/**  Start loading an asset and its dependencies in the background
+	 * @param  AssetPath  the asset to load
+	 * @return  false if the asset couldn't be requested
+	 */
+	bool Prefetch(const FSoftObjectPath& AssetPath);
+
+	/** whether a prefetch or a pin of the asset was requested and it finished loading */
+	bool IsPrefetched(const FSoftObjectPath& AssetPath) const;
+
+	/**  Load an asset and its dependencies in the background and keep them loaded until it's unpinned
+	 * the pinned assets don't count against the recent prefetches, the favorite entries are pinned
+	 * @return  false if the asset couldn't be requested
+	 */
+	bool Pin(const FSoftObjectPath& AssetPath);
+	void Unpin(const FSoftObjectPath& AssetPath);
+
+	/** Drop the cached load sets */
+	void Invalidate();
+
+private:
+	void HandlePackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext);
+	int64 GetPackageDiskSize(FName PackageName);
+
+	TMap<FName, FSimpleAssetLibraryLoadSet> LoadSets;
+	TMap<FName, int64> PackageDiskSizes;
+
+	FStreamableManager StreamableManager;
+
+	/** the handles keep the prefetched assets loaded, the most recent prefetch is last */
+	TArray<TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>> Prefetches;
+	TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> Pins;
+
+	FDelegateHandle PackageSavedHandle;
+};
@@ -0,0 +1,80 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Containers/Ticker.h"
+#include "SimpleAssetLibrarySubsystem.h"
+
+class FJsonObject;
+
+
+/*
+*	The user settings of the Asset Library windows, read once and kept in memory.
+*
+*	Saving only updates the settings in memory, the file is written in the background shortly after
+*	the last change so a burst of saves while a window is edited or restored costs a single write.
+*	The file is written next to the previous one then renamed over it, it is never left half written.
+*/
+class SIMPLEASSETLIBRARY_API FSimpleAssetLibraryPrefsStore
+{
+public:
+	explicit FSimpleAssetLibraryPrefsStore(const FString& InFilename);
+	~FSimpleAssetLibraryPrefsStore();
+
+	/** Get the settings store owned by the SimpleAssetLibrary module */
+	static FSimpleAssetLibraryPrefsStore& Get();
+
+	/**  Get the settings of a window, the file is only read the first time
+	 * @param  PanelName  the name of the window, None for the main window
+	 * @param  OutPrefs  the saved settings, the defaults for the settings that were never saved
+	 * @return  false if no settings were saved yet
+	 */
+	bool Load(FName PanelName, FSimpleAssetLibraryPrefs& OutPrefs);
+
+	/**  Update the settings of a window, the file is written shortly after the last update
+	 * @param  Prefs  the settings of the window
+	 * @param  PanelName  the name of the window, None for the main window
+	 * @return  whether the settings changed
+	 */
+	bool Save(const FSimpleAssetLibraryPrefs& Prefs, FName PanelName);
+
+	/**  Get a list of names saved with the settings, like the recently placed entries
+	 * @param  Key  the json key of the list
+	 */
+	TArray<FName> GetNames(const TCHAR* Key);
+
+	/**  Save a list of names with the settings, the file is written shortly after the last update
+	 * @param  Key  the json key of the list
+	 * @param  Names  the list to save
+	 */
+	void SetNames(const TCHAR* Key, TConstArrayView<FName> Names);
+
+	/** Write the pending changes now and wait for the file to be written */
+	void Flush();
+
+	const FString& GetFilename() const { return Filename; }
+
+private:
+	void ReadIfNeeded();
+
+	/** Schedule the write of the settings if they changed, returns false if they didn't */
+	bool ScheduleWrite();
+	bool TickWrite(float DeltaTime);
+	void StartWrite();
+
+	FString Filename;
+
+	/** the settings of every window, the keys the Python commands used */
+	TSharedPtr<FJsonObject> Json;
+
+	/** the serialized settings, compared to skip the saves that change nothing */
+	FString Text;
+	bool bRead = false;
+
+	/** when the pending changes are written */
+	double WriteTime = 0.0;
+	FTSTicker::FDelegateHandle WriteTickerHandle;
+	TFuture<bool> PendingWrite;
+};
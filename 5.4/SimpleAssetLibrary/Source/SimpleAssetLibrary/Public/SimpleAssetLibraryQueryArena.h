@@ -0,0 +1,48 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <type_traits>
+
+
+/*
+*	Linear allocator for the scratch memory of library queries, owned by each library panel.
+*
+*	Allocations are never freed one by one, Reset() rewinds the arena before the next query and keeps
+*	its memory. A panel filtering on every keystroke stops going to the heap once the arena reached
+*	the working size of its queries. Only trivially destructible types can be allocated.
+*/
+class SIMPLEASSETLIBRARY_API FSimpleAssetLibraryQueryArena
+{
+public:
+	explicit FSimpleAssetLibraryQueryArena(int64 InitialSize = 64 * 1024);
+	~FSimpleAssetLibraryQueryArena();
+
+	FSimpleAssetLibraryQueryArena(const FSimpleAssetLibraryQueryArena&) = delete;
+	FSimpleAssetLibraryQueryArena& operator=(const FSimpleAssetLibraryQueryArena&) = delete;
+
+	/**  Allocate an uninitialized array, it stays valid until the next Reset()
+	 * @param  Num  the number of elements
+	 */
+	template <typename ElementType>
+	TArrayView<ElementType> Allocate(int32 Num)
+	{
+		static_assert(std::is_trivially_destructible_v<ElementType>, "the query arena never runs destructors");
+		return TArrayView<ElementType>(static_cast<ElementType*>(AllocateBytes(Num * sizeof(ElementType), alignof(ElementType))), Num);
+	}
+
+	/** Release every allocation, the memory is kept for the next query */
+	void Reset();
+
+	int64 GetCapacity() const { return Capacity; }
+
+private:
+	void* AllocateBytes(int64 Size, int64 Alignment);
+	void AddBlock(int64 Size);
+
+	TArray<TArray64<uint8>> Blocks;
+	int32 CurrentBlock = 0;
+	int64 CurrentOffset = 0;
+	int64 Capacity = 0;
+};
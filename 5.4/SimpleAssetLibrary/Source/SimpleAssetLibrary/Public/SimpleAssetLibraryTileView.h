@@ -0,0 +1,170 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Components/Widget.h"
+#include "SimpleAssetLibraryBPLibrary.h"
+#include "SimpleAssetLibraryEntryStore.h"
+#include "SimpleAssetLibraryQueryArena.h"
+#include "Widgets/Views/STileView.h"
+#include "SimpleAssetLibraryTileView.generated.h"
+
+class SSimpleAssetLibraryTile;
+class UTexture2D;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSimpleAssetLibraryEntryEvent, const FSimpleAssetLibraryEntryInfo&, Entry);
+
+/** What a tile view has to update before it's next painted */
+enum class ESimpleAssetLibraryViewDirty : uint8
+{
+	None = 0,
+
+	/** the asset type, category or search text changed, the index is queried again */
+	Query = 1 << 0,
+
+	/** the entry size changed, the tiles are resized */
+	Layout = 1 << 1,
+};
+ENUM_CLASS_FLAGS(ESimpleAssetLibraryViewDirty);
+
+/*
+*	Virtualized grid of the library entries, bound to the native library index.
+*
+*	Only the tiles of the visible rows are created, tiles scrolled out of view are released to a pool
+*	and reused for the rows scrolled into view. Items are handles into the index rows so a category
+*	of 20k entries costs a handle per entry plus the visible tiles, not a widget per entry.
+*
+*	Changing the filter or the entry size only marks the view dirty, the view is updated once before
+*	it's next painted. Restoring a window sets the type, category, search text and size in a row,
+*	that costs a single query and layout.
+*/
+UCLASS(meta = (DisplayName = "Asset Library Tile View"))
+class SIMPLEASSETLIBRARY_API USimpleAssetLibraryTileView : public UWidget
+{
+	GENERATED_BODY()
+
+public:
+	/** width of a tile, in slate units, before the entry scale is applied */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Library")
+	float EntryWidth = 128.0f;
+
+	/** height of a tile, in slate units, before the entry scale is applied */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Library")
+	float EntryHeight = 160.0f;
+
+	/** the texture shown while a thumbnail is loading or for entries without a thumbnail */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Library")
+	TObjectPtr<UTexture2D> DefaultThumbnail;
+
+	/** whether the search results show the most placed entries first */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Library")
+	bool bRankSearchResultsByUsage = true;
+
+	UPROPERTY(BlueprintAssignable, Category = "Asset Library")
+	FOnSimpleAssetLibraryEntryEvent OnEntryClicked;
+
+	UPROPERTY(BlueprintAssignable, Category = "Asset Library")
+	FOnSimpleAssetLibraryEntryEvent OnEntryDoubleClicked;
+
+	/**  Show the entries of the given asset type + category
+	 * @param  AssetType  the asset type to show, 'all' shows every type
+	 * @param  Category  the category to show, 'all' shows every category
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Tile View")
+	void SetQuery(FName AssetType, FName Category);
+
+	/**  Only show the entries whose display name or asset name contains the given text
+	 * @param  Text  the text to search for, empty to show every entry of the query
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Tile View")
+	void SetSearchText(const FString& Text);
+
+	/**  Show the entries matching a compound filter, replaces the query and the search text
+	 * @param  InFilter  the asset types, categories, authors, classes and search text to match
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Tile View")
+	void SetFilter(const FSimpleAssetLibraryFilter& InFilter);
+
+	UFUNCTION(BlueprintPure, Category = "Asset Library | Tile View")
+	FSimpleAssetLibraryFilter GetFilter() const { return Filter; }
+
+	/**  Scale the tiles, matches the entry_size setting of the Asset Library
+	 * @param  Scale  the tile scale, 1.0 is EntryWidth x EntryHeight
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Tile View")
+	void SetEntryScale(float Scale);
+
+	/** Query the library index again before the view is next painted, call after the library entries changed */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Tile View")
+	void Refresh();
+
+	/** Apply the pending filter and size changes now rather than before the view is next painted */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Tile View")
+	void FlushRefresh();
+
+	/** Get the library data of the selected entries */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Tile View")
+	TArray<FSimpleAssetLibraryEntryInfo> GetSelectedEntries() const;
+
+	/** Async load the selected entries and their dependencies, before they are placed */
+	UFUNCTION(BlueprintCallable, Category = "Asset Library | Tile View")
+	void PrefetchSelectedEntries();
+
+	/** the number of entries matching the current filter, pending filter changes are applied first */
+	UFUNCTION(BlueprintPure, Category = "Asset Library | Tile View")
+	int32 GetNumEntries();
+
+	//~ Begin UWidget Interface
+	virtual void SynchronizeProperties() override;
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+#if WITH_EDITOR
+	virtual const FText GetPaletteCategory() override;
+#endif
+	//~ End UWidget Interface
+
+protected:
+	//~ Begin UWidget Interface
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+	//~ End UWidget Interface
+
+private:
+	using FItem = TSharedPtr<FSimpleAssetLibraryEntryHandle>;
+
+	void MarkDirty(ESimpleAssetLibraryViewDirty InDirty);
+	EActiveTimerReturnType HandleRefreshTimer(double InCurrentTime, float InDeltaTime);
+	void HandleEntriesChanged();
+	void UpdateItems();
+	void UpdateTileSize();
+
+	TSharedRef<ITableRow> GenerateTile(FItem Item, const TSharedRef<STableViewBase>& OwnerTable);
+	void ReleaseTile(const TSharedRef<ITableRow>& Row);
+	void HandleClick(FItem Item);
+	void HandleDoubleClick(FItem Item);
+	bool GetItemInfo(const FItem& Item, FSimpleAssetLibraryEntryInfo& OutInfo) const;
+
+	TSharedPtr<STileView<FItem>> TileView;
+	TArray<FItem> Items;
+
+	/** the item of every store row, made once and handed out by every query until the rows move */
+	TArray<FItem> ItemsByRow;
+	int32 ItemsSerial = INDEX_NONE;
+
+	/** the scratch memory of this panel's queries, reset before each query */
+	FSimpleAssetLibraryQueryArena QueryArena;
+
+	/** tiles released by rows that scrolled out of view, reused before new ones are created */
+	TArray<TSharedRef<SSimpleAssetLibraryTile>> TilePool;
+	TMap<const ITableRow*, TSharedRef<SSimpleAssetLibraryTile>> TilesByRow;
+
+	/** the criteria and search text of the shown entries, empty matches everything */
+	FSimpleAssetLibraryFilter Filter;
+	float EntryScale = 1.0f;
+
+	ESimpleAssetLibraryViewDirty Dirty = ESimpleAssetLibraryViewDirty::None;
+
+	/** the timer of the pending update, it runs once on the next Slate tick */
+	TWeakPtr<FActiveTimerHandle> RefreshTimer;
+
+	/** the shown entries are queried again when the index changes, while the view is constructed */
+	FDelegateHandle EntriesChangedHandle;
+};